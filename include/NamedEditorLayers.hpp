@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Geode/loader/Dispatch.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef MY_MOD_ID
+    #undef MY_MOD_ID
+#endif
+#define MY_MOD_ID "razoom.named_editor_layers"
+
+class GameObject;
+
+// API of Named Editor Layers for other editor mods.
+// All functions are main thread only and return an error when the editor is not open.
+namespace named_layers {
+    // increased on any incompatible change of this header
+    constexpr int API_VERSION = 1;
+
+    using LayerNames = std::unordered_map<int, std::string>;
+    // immutable: a snapshot you got from getLayerNames can be kept and read from any thread
+    using NamesSnapshot = std::shared_ptr<const LayerNames>;
+
+    // all changes of one frame
+    struct LayerChanges {
+        // version of the name table after these changes
+        uint64_t m_namesVersion;
+        // {layer, new name}, empty name - the name was removed
+        std::vector<std::pair<int, std::string>> m_names;
+        // {layer, new object count}
+        std::vector<std::pair<int, int>> m_counts;
+    };
+
+    using ChangesCallback = std::function<void(const LayerChanges& changes)>;
+
+    inline geode::Result<int> getApiVersion() GEODE_EVENT_EXPORT(&getApiVersion, ());
+
+    inline geode::Result<NamesSnapshot> getLayerNames() GEODE_EVENT_EXPORT(&getLayerNames, ());
+
+    // Counts and objects come from an index that is updated as objects are added, removed
+    // or changed in the editor, and the selection is checked every frame. Layers that
+    // another mod writes to objects outside the selection are picked up on undo, redo
+    // or when the layer list is opened.
+
+    // object counts of the used layers (objects with two layers count in both)
+    inline geode::Result<std::unordered_map<int, int>> getObjectCounts() GEODE_EVENT_EXPORT(&getObjectCounts, ());
+
+    // objects of the layer, valid until they are removed from the level
+    inline geode::Result<std::vector<GameObject*>> getObjects(int layer) GEODE_EVENT_EXPORT(&getObjects, (layer));
+
+    // the callback is called on the main thread once per frame that has changes.
+    // In the editor it is also called right away with the whole state (all names and
+    // counts), the same happens for the first frame after the editor opens.
+    // returns the id for removeChangesListener
+    inline geode::Result<size_t> addChangesListener(ChangesCallback callback) GEODE_EVENT_EXPORT(&addChangesListener, (std::move(callback)));
+
+    inline geode::Result<void> removeChangesListener(size_t id) GEODE_EVENT_EXPORT(&removeChangesListener, (id));
+}
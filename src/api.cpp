@@ -0,0 +1,55 @@
+// only this file defines the exported functions, see Geode/loader/Dispatch.hpp
+#define GEODE_DEFINE_EVENT_EXPORTS
+#include "../include/NamedEditorLayers.hpp"
+#include "apiBridge.hpp"
+#include <Geode/Geode.hpp>
+
+using namespace geode::prelude;
+
+
+// listeners can be added before the editor is opened
+std::vector<std::pair<size_t, named_layers::ChangesCallback>>& api_bridge::changesListeners() {
+    static std::vector<std::pair<size_t, named_layers::ChangesCallback>> listeners;
+    return listeners;
+}
+
+
+Result<int> named_layers::getApiVersion() {
+    return Ok(API_VERSION);
+}
+
+
+Result<named_layers::NamesSnapshot> named_layers::getLayerNames() {
+    if (!api_bridge::isInEditor()) return Err("Not in the editor");
+    return Ok(api_bridge::layerNames());
+}
+
+
+Result<std::unordered_map<int, int>> named_layers::getObjectCounts() {
+    if (!api_bridge::isInEditor()) return Err("Not in the editor");
+    return Ok(api_bridge::objectCounts());
+}
+
+
+Result<std::vector<GameObject*>> named_layers::getObjects(int layer) {
+    if (!api_bridge::isInEditor()) return Err("Not in the editor");
+    return Ok(api_bridge::objects(layer));
+}
+
+
+Result<size_t> named_layers::addChangesListener(ChangesCallback callback) {
+    static size_t nextId = 1;
+    size_t id = nextId++;
+    api_bridge::changesListeners().push_back({id, callback});
+    // the later calls contain only the changes
+    if (api_bridge::isInEditor()) {
+        callback(api_bridge::currentState());
+    }
+    return Ok(id);
+}
+
+
+Result<void> named_layers::removeChangesListener(size_t id) {
+    std::erase_if(api_bridge::changesListeners(), [id](const auto& item) { return item.first == id; });
+    return Ok();
+}
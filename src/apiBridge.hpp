@@ -0,0 +1,15 @@
+#pragma once
+
+// connects the exported API (api.cpp) with the editor hooks (main.cpp)
+namespace api_bridge {
+    // main.cpp
+    bool isInEditor();
+    named_layers::NamesSnapshot layerNames();
+    std::unordered_map<int, int> objectCounts();
+    std::vector<GameObject*> objects(int layer);
+    // all names and counts, for a new listener
+    named_layers::LayerChanges currentState();
+
+    // api.cpp
+    std::vector<std::pair<size_t, named_layers::ChangesCallback>>& changesListeners();
+}
@@ -0,0 +1,258 @@
+class BatchApplyPopup : public Popup {
+private:
+    const float m_width = 380.f;
+    const float m_height = 280.f;
+    // how much time the worker may take per frame
+    const std::chrono::milliseconds m_frameBudget{8};
+
+    Ref<GJGameLevel> m_sourceLevel;
+    LayerNames m_sourceNames;
+
+    std::vector<Ref<GJGameLevel>> m_levels;
+    std::vector<bool> m_selected;
+    std::vector<CCMenuItemToggler*> m_togglers;
+
+    bool m_merge = true;
+    bool m_running = false;
+    std::vector<Ref<GJGameLevel>> m_queue;
+    size_t m_done = 0;
+
+    CCLabelBMFont* m_statusLab = nullptr;
+    CCMenuItemSpriteExtra* m_applyBtn = nullptr;
+    CCMenuItemSpriteExtra* m_cancelBtn = nullptr;
+
+protected:
+    bool init(GJGameLevel* source, LayerNameTable::Snapshot sourceNames) {
+        if (!Popup::init(m_width, m_height))
+            return false;
+
+        m_sourceLevel = source;
+        m_sourceNames = *sourceNames;
+        setTitle("Apply Layer Names");
+
+        for (auto* level : CCArrayExt<GJGameLevel*>(LocalLevelManager::get()->m_localLevels)) {
+            if (level == source) continue;
+            m_levels.push_back(level);
+        }
+        m_selected.assign(m_levels.size(), false);
+
+        auto menu = CCMenu::create();
+        menu->setContentSize(m_mainLayer->getContentSize());
+        m_mainLayer->addChildAtPosition(menu, Anchor::Center);
+
+        auto infoBtn = InfoAlertButton::create("Help",
+            "Copies the layer names of <cy>this level</c> to the <cl>selected levels</c>.\n"
+            "<cg>Merge</c>: names of the selected levels are kept, same layers are overwritten.\n"
+            "<cr>Replace</c>: names of the selected levels are replaced completely.", 0.75);
+        menu->addChildAtPosition(infoBtn, Anchor::TopRight, ccp(-18, -18));
+
+        auto mergeBtn = CCMenuItemToggler::createWithStandardSprites(this, menu_selector(BatchApplyPopup::onMergeToggle), 0.6f);
+        mergeBtn->toggle(m_merge);
+        menu->addChildAtPosition(mergeBtn, Anchor::BottomLeft, ccp(32, 22));
+        auto mergeLab = CCLabelBMFont::create("Merge", "bigFont.fnt");
+        mergeLab->setScale(0.4);
+        mergeLab->setAnchorPoint({0,0.5});
+        menu->addChildAtPosition(mergeLab, Anchor::BottomLeft, ccp(48, 22));
+
+        auto allSpr = ButtonSprite::create("All", "bigFont.fnt", "GJ_button_04.png", 0.8);
+        allSpr->setScale(0.5);
+        auto allBtn = CCMenuItemSpriteExtra::create(allSpr, this, menu_selector(BatchApplyPopup::onSelectAll));
+        menu->addChildAtPosition(allBtn, Anchor::BottomLeft, ccp(125, 22));
+
+        auto noneSpr = ButtonSprite::create("None", "bigFont.fnt", "GJ_button_04.png", 0.8);
+        noneSpr->setScale(0.5);
+        auto noneBtn = CCMenuItemSpriteExtra::create(noneSpr, this, menu_selector(BatchApplyPopup::onSelectNone));
+        menu->addChildAtPosition(noneBtn, Anchor::BottomLeft, ccp(170, 22));
+
+        auto applySpr = ButtonSprite::create("Apply", "goldFont.fnt", "GJ_button_01.png", 0.8);
+        applySpr->setScale(0.7);
+        m_applyBtn = CCMenuItemSpriteExtra::create(applySpr, this, menu_selector(BatchApplyPopup::onApply));
+        menu->addChildAtPosition(m_applyBtn, Anchor::BottomRight, ccp(-50, 22));
+
+        auto cancelSpr = ButtonSprite::create("Cancel", "goldFont.fnt", "GJ_button_06.png", 0.8);
+        cancelSpr->setScale(0.7);
+        m_cancelBtn = CCMenuItemSpriteExtra::create(cancelSpr, this, menu_selector(BatchApplyPopup::onCancel));
+        m_cancelBtn->setVisible(false);
+        menu->addChildAtPosition(m_cancelBtn, Anchor::BottomRight, ccp(-50, 22));
+
+        m_statusLab = CCLabelBMFont::create("", "chatFont.fnt");
+        m_statusLab->setAnchorPoint({1,0.5});
+        m_mainLayer->addChildAtPosition(m_statusLab, Anchor::BottomRight, ccp(-95, 22));
+        updateStatus(fmt::format("{} names", m_sourceNames.size()));
+
+        setupScrollLayer();
+        setID("batch-apply-popup"_spr);
+        return true;
+    }
+
+
+    void setupScrollLayer() {
+        const float cellHeight = 25;
+        const float cellWidth = m_width - 40;
+
+        auto scroll = ScrollLayer::create({m_width - 40, m_height - 85});
+        m_mainLayer->addChild(scroll);
+        scroll->setPosition({20,45});
+
+        int btnCount = 0;
+        for (auto& level : m_levels) {
+            auto cell = CCLayerColor::create(btnCount % 2 ? ccc4(161,88,44,255) : ccc4(194,114,62,255), cellWidth, cellHeight);
+
+            auto nameLab = CCLabelBMFont::create(std::string(level->m_levelName).c_str(), "bigFont.fnt");
+            nameLab->setAnchorPoint({0,0.5});
+            nameLab->limitLabelWidth(220, 0.5, 0);
+            cell->addChildAtPosition(nameLab, Anchor::Left, ccp(10, 0));
+
+            auto menu = CCMenu::create();
+            cell->addChild(menu);
+            menu->setContentSize(cell->getContentSize());
+            menu->setPosition(cell->getContentSize() / 2.f);
+
+            auto toggler = CCMenuItemToggler::createWithStandardSprites(this, menu_selector(BatchApplyPopup::onLevelToggle), 0.55f);
+            toggler->setTag(btnCount);
+            menu->addChildAtPosition(toggler, Anchor::Right, ccp(-25, 0));
+            m_togglers.push_back(toggler);
+
+            scroll->m_contentLayer->addChild(cell);
+            btnCount++;
+        }
+
+        scroll->m_contentLayer->setContentHeight(std::max(cellHeight * btnCount, scroll->getContentHeight()));
+        scroll->m_contentLayer->setLayout(ColumnLayout::create()->setAutoScale(false)->setAxisReverse(true)->setGap(0)->setCrossAxisLineAlignment(AxisAlignment::Start)->setAxisAlignment(AxisAlignment::End));
+        scroll->scrollToTop();
+
+        if (cellHeight * btnCount > scroll->getContentHeight()) {
+            auto bar = Scrollbar::create(scroll);
+            bar->setPosition(scroll->getPosition() + scroll->getContentSize() + ccp(3,0));
+            bar->setAnchorPoint({0,1});
+            bar->setScaleX(1.15);
+            m_mainLayer->addChild(bar, 5);
+        }
+
+        auto border = ListBorders::create();
+        border->setSpriteFrames("GJ_commentTop_001.png", "GJ_commentSide_001.png");
+        scroll->addChild(border, 3);
+        border->setContentSize(scroll->getContentSize());
+        border->setPosition(scroll->getContentSize() / 2);
+    }
+
+
+    void updateStatus(const std::string& text) {
+        m_statusLab->setString(text.c_str());
+        m_statusLab->limitLabelWidth(120, 0.7, 0);
+    }
+
+
+    void onLevelToggle(CCObject* sender) {
+        // the toggler changes its state after the callback
+        int idx = sender->getTag();
+        m_selected[idx] = !static_cast<CCMenuItemToggler*>(sender)->isToggled();
+    }
+
+
+    void setAllSelected(bool value) {
+        if (m_running) return;
+        m_selected.assign(m_levels.size(), value);
+        for (auto* toggler : m_togglers) {
+            toggler->toggle(value);
+        }
+    }
+
+
+    void onSelectAll(CCObject*) {
+        setAllSelected(true);
+    }
+
+
+    void onSelectNone(CCObject*) {
+        setAllSelected(false);
+    }
+
+
+    void onMergeToggle(CCObject* sender) {
+        m_merge = !static_cast<CCMenuItemToggler*>(sender)->isToggled();
+    }
+
+
+    void onApply(CCObject*) {
+        if (m_running) return;
+        m_queue.clear();
+        for (size_t i = 0; i < m_levels.size(); i++) {
+            if (m_selected[i]) m_queue.push_back(m_levels[i]);
+        }
+        if (m_queue.empty()) {
+            updateStatus("Nothing selected");
+            return;
+        }
+        m_done = 0;
+        m_running = true;
+        m_applyBtn->setVisible(false);
+        m_cancelBtn->setVisible(true);
+        updateStatus(fmt::format("0 / {}", m_queue.size()));
+        schedule(schedule_selector(BatchApplyPopup::processQueue), 0);
+    }
+
+
+    // levels are processed in small portions every frame, because GD levels
+    // and the Save Level Data API can only be accessed from the main thread
+    void processQueue(float) {
+        auto start = std::chrono::steady_clock::now();
+        while (m_done < m_queue.size()) {
+            applyTo(m_queue[m_done]);
+            m_done++;
+            if (std::chrono::steady_clock::now() - start > m_frameBudget) break;
+        }
+        updateStatus(fmt::format("{} / {}", m_done, m_queue.size()));
+        if (m_done == m_queue.size()) {
+            stop();
+            updateStatus(fmt::format("Done: {} levels", m_done));
+        }
+    }
+
+
+    // reads (only for merging) and writes the level data once
+    void applyTo(GJGameLevel* level) {
+        LayerNames names;
+        if (m_merge) {
+            names = loadLayerNames(level);
+        }
+        for (const auto& [layer, name] : m_sourceNames) {
+            names.insert_or_assign(layer, name);
+        }
+        saveLayerNames(level, names);
+    }
+
+
+    void stop() {
+        unschedule(schedule_selector(BatchApplyPopup::processQueue));
+        m_running = false;
+        m_queue.clear();
+        m_applyBtn->setVisible(true);
+        m_cancelBtn->setVisible(false);
+    }
+
+
+    void onCancel(CCObject*) {
+        if (!m_running) return;
+        size_t done = m_done, total = m_queue.size();
+        stop();
+        updateStatus(fmt::format("Cancelled: {} / {}", done, total));
+    }
+
+public:
+    static BatchApplyPopup* create(GJGameLevel* source, LayerNameTable::Snapshot sourceNames) {
+        auto ret = new BatchApplyPopup();
+        if (ret && ret->init(source, std::move(sourceNames))) {
+            ret->autorelease();
+            return ret;
+        }
+        CC_SAFE_DELETE(ret);
+        return nullptr;
+    }
+
+
+    void onClose(CCObject* sender) override {
+        if (m_running) stop();
+        Popup::onClose(sender);
+    }
+};
@@ -0,0 +1,94 @@
+class FolderPopup : public Popup {
+private:
+    const float m_width = 260.f;
+    const float m_height = 150.f;
+
+    std::vector<LayerFolder> m_folders; // existing ones
+    std::function<void(LayerFolder folder)> m_createCallback;
+
+    TextInput* m_nameInput = nullptr;
+    TextInput* m_firstInput = nullptr;
+    TextInput* m_lastInput = nullptr;
+    CCLabelBMFont* m_errorLab = nullptr;
+
+protected:
+    bool init(std::vector<LayerFolder> folders, std::function<void(LayerFolder folder)> createCallback) {
+        if (!Popup::init(m_width, m_height))
+            return false;
+
+        m_folders = std::move(folders);
+        m_createCallback = createCallback;
+        setTitle("New Layer Folder");
+
+        auto menu = CCMenu::create();
+        menu->setContentSize(m_mainLayer->getContentSize());
+        m_mainLayer->addChildAtPosition(menu, Anchor::Center);
+
+        auto infoBtn = InfoAlertButton::create("Folder Help", "A folder groups the layers of the range in the layer list. A folder can be inside another one, but two folders can't partly overlap", 0.75);
+        menu->addChildAtPosition(infoBtn, Anchor::TopRight, ccp(-18, -18));
+
+        m_nameInput = TextInput::create(m_width - 40, "Folder name");
+        m_nameInput->setCommonFilter(CommonFilter::Any);
+        m_mainLayer->addChildAtPosition(m_nameInput, Anchor::Top, ccp(0, -55));
+
+        m_firstInput = TextInput::create(70, "from");
+        m_firstInput->setCommonFilter(CommonFilter::Int);
+        m_mainLayer->addChildAtPosition(m_firstInput, Anchor::Top, ccp(-45, -90));
+
+        m_lastInput = TextInput::create(70, "to");
+        m_lastInput->setCommonFilter(CommonFilter::Int);
+        m_mainLayer->addChildAtPosition(m_lastInput, Anchor::Top, ccp(45, -90));
+
+        m_errorLab = CCLabelBMFont::create("", "chatFont.fnt");
+        m_errorLab->setColor(ccc3(255,90,90));
+        m_mainLayer->addChildAtPosition(m_errorLab, Anchor::Top, ccp(0, -112));
+
+        auto okBtn = CCMenuItemSpriteExtra::create(ButtonSprite::create("ok", "goldFont.fnt", "GJ_button_01.png", 1), this, menu_selector(FolderPopup::onOk));
+        menu->addChildAtPosition(okBtn, Anchor::Bottom);
+
+        setID("folder-popup"_spr);
+        return true;
+    }
+
+
+    void onOk(CCObject*) {
+        int first = utils::numFromString<int>(m_firstInput->getString()).unwrapOr(-1);
+        int last = utils::numFromString<int>(m_lastInput->getString()).unwrapOr(-1);
+        if (first < 0 || last < 0 || first >= LAYER_COUNT || last >= LAYER_COUNT) {
+            m_errorLab->setString(fmt::format("Layers must be 0-{}", LAYER_COUNT - 1).c_str());
+            return;
+        }
+        if (first > last) std::swap(first, last);
+        // a folder is inside, outside or apart from any other one
+        for (const auto& folder : m_folders) {
+            bool apart = last < folder.m_first || first > folder.m_last;
+            bool inside = first >= folder.m_first && last <= folder.m_last;
+            bool outside = first <= folder.m_first && last >= folder.m_last;
+            if (first == folder.m_first && last == folder.m_last) {
+                m_errorLab->setString(fmt::format("'{}' has the same range", folder.m_name).c_str());
+                return;
+            }
+            if (!apart && !inside && !outside) {
+                m_errorLab->setString(fmt::format("Overlaps '{}' ({}-{})", folder.m_name, folder.m_first, folder.m_last).c_str());
+                return;
+            }
+        }
+        auto name = m_nameInput->getString();
+        if (name.empty()) name = fmt::format("{}-{}", first, last);
+
+        auto callback = m_createCallback;
+        onClose(nullptr);
+        callback({name, first, last});
+    }
+
+public:
+    static FolderPopup* create(std::vector<LayerFolder> folders, std::function<void(LayerFolder folder)> createCallback) {
+        auto ret = new FolderPopup();
+        if (ret && ret->init(std::move(folders), createCallback)) {
+            ret->autorelease();
+            return ret;
+        }
+        CC_SAFE_DELETE(ret);
+        return nullptr;
+    }
+};
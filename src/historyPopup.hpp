@@ -0,0 +1,163 @@
+// what the popup shows, every callback returns the new state
+struct HistoryState {
+    size_t m_version;
+    std::vector<LayerHistory::Snapshot> m_snapshots;
+};
+
+
+struct HistoryInfo {
+    HistoryState m_state;
+    std::function<HistoryState()> m_undoCallback;
+    std::function<HistoryState()> m_redoCallback;
+    std::function<HistoryState(std::string label)> m_snapshotCallback;
+    std::function<HistoryState(size_t version)> m_restoreCallback;
+};
+
+
+class HistoryPopup : public Popup {
+private:
+    const float m_width = 300.f;
+    const float m_height = 280.f;
+
+    HistoryInfo m_historyInfo;
+
+    ScrollLayer* m_scroll = nullptr;
+    TextInput* m_labelInput = nullptr;
+    CCLabelBMFont* m_statusLab = nullptr;
+
+protected:
+    bool init(HistoryInfo historyInfo) {
+        if (!Popup::init(m_width, m_height))
+            return false;
+
+        m_historyInfo = historyInfo;
+        setTitle("Layer Names History");
+
+        auto menu = CCMenu::create();
+        menu->setContentSize(m_mainLayer->getContentSize());
+        m_mainLayer->addChildAtPosition(menu, Anchor::Center);
+
+        auto infoBtn = InfoAlertButton::create("Help",
+            "Use <cy>undo</c> and <cy>redo</c> to revert the renames.\n"
+            "<cl>Snapshots</c> keep the whole list of names, use the <cy>restore</c> button to go back to one of them.", 0.75);
+        menu->addChildAtPosition(infoBtn, Anchor::TopRight, ccp(-18, -18));
+
+        auto undoSpr = ButtonSprite::create("Undo", "bigFont.fnt", "GJ_button_04.png", 0.8);
+        undoSpr->setScale(0.5);
+        auto undoBtn = CCMenuItemSpriteExtra::create(undoSpr, this, menu_selector(HistoryPopup::onUndo));
+        menu->addChildAtPosition(undoBtn, Anchor::Top, ccp(-45, -50));
+
+        auto redoSpr = ButtonSprite::create("Redo", "bigFont.fnt", "GJ_button_04.png", 0.8);
+        redoSpr->setScale(0.5);
+        auto redoBtn = CCMenuItemSpriteExtra::create(redoSpr, this, menu_selector(HistoryPopup::onRedo));
+        menu->addChildAtPosition(redoBtn, Anchor::Top, ccp(45, -50));
+
+        m_labelInput = TextInput::create(170, "Snapshot name");
+        m_labelInput->setCommonFilter(CommonFilter::Any);
+        m_labelInput->setScale(0.8);
+        m_mainLayer->addChildAtPosition(m_labelInput, Anchor::Top, ccp(-40, -82));
+
+        auto snapSpr = ButtonSprite::create("Save", "goldFont.fnt", "GJ_button_01.png", 0.8);
+        snapSpr->setScale(0.6);
+        auto snapBtn = CCMenuItemSpriteExtra::create(snapSpr, this, menu_selector(HistoryPopup::onTakeSnapshot));
+        menu->addChildAtPosition(snapBtn, Anchor::Top, ccp(95, -82));
+
+        m_statusLab = CCLabelBMFont::create("", "chatFont.fnt");
+        m_mainLayer->addChildAtPosition(m_statusLab, Anchor::Bottom, ccp(0, 12));
+
+        m_scroll = ScrollLayer::create({m_width - 40, m_height - 125});
+        m_mainLayer->addChild(m_scroll);
+        m_scroll->setPosition({20,25});
+
+        auto border = ListBorders::create();
+        border->setSpriteFrames("GJ_commentTop_001.png", "GJ_commentSide_001.png");
+        m_scroll->addChild(border, 3);
+        border->setContentSize(m_scroll->getContentSize());
+        border->setPosition(m_scroll->getContentSize() / 2);
+
+        updateList();
+        setID("history-popup"_spr);
+        return true;
+    }
+
+
+    void updateList() {
+        const float cellHeight = 25;
+        const float cellWidth = m_width - 40;
+        auto& state = m_historyInfo.m_state;
+        auto content = m_scroll->m_contentLayer;
+        content->removeAllChildren();
+
+        // newest first
+        auto& snapshots = state.m_snapshots;
+        int btnCount = 0;
+        for (int i = (int)snapshots.size() - 1; i >= 0; i--) {
+            auto cell = CCLayerColor::create(btnCount % 2 ? ccc4(161,88,44,255) : ccc4(194,114,62,255), cellWidth, cellHeight);
+
+            auto nameLab = CCLabelBMFont::create(snapshots[i].m_label.c_str(), "bigFont.fnt");
+            nameLab->setAnchorPoint({0,0.5});
+            nameLab->limitLabelWidth(160, 0.5, 0);
+            cell->addChildAtPosition(nameLab, Anchor::Left, ccp(10, 0));
+
+            auto menu = CCMenu::create();
+            cell->addChild(menu);
+            menu->setContentSize(cell->getContentSize());
+            menu->setPosition(cell->getContentSize() / 2.f);
+
+            auto restoreSpr = ButtonSprite::create("restore", "bigFont.fnt", "GJ_button_01.png", 0.8);
+            restoreSpr->setScale(0.45);
+            auto restoreBtn = CCMenuItemSpriteExtra::create(restoreSpr, this, menu_selector(HistoryPopup::onRestore));
+            restoreBtn->setTag(i);
+            menu->addChildAtPosition(restoreBtn, Anchor::Right, ccp(-35, 0));
+
+            content->addChild(cell);
+            btnCount++;
+        }
+
+        content->setContentHeight(std::max(cellHeight * btnCount, m_scroll->getContentHeight()));
+        content->setLayout(ColumnLayout::create()->setAutoScale(false)->setAxisReverse(true)->setGap(0)->setCrossAxisLineAlignment(AxisAlignment::Start)->setAxisAlignment(AxisAlignment::End));
+        m_scroll->scrollToTop();
+
+        m_statusLab->setString(fmt::format("Version: {}", state.m_version).c_str());
+        m_statusLab->limitLabelWidth(m_width - 40, 0.6, 0);
+    }
+
+
+    void onUndo(CCObject*) {
+        m_historyInfo.m_state = m_historyInfo.m_undoCallback();
+        updateList();
+    }
+
+
+    void onRedo(CCObject*) {
+        m_historyInfo.m_state = m_historyInfo.m_redoCallback();
+        updateList();
+    }
+
+
+    void onTakeSnapshot(CCObject*) {
+        auto label = m_labelInput->getString();
+        if (label.empty()) label = fmt::format("Version {}", m_historyInfo.m_state.m_version);
+        m_historyInfo.m_state = m_historyInfo.m_snapshotCallback(label);
+        m_labelInput->setString("");
+        updateList();
+    }
+
+
+    void onRestore(CCObject* sender) {
+        auto version = m_historyInfo.m_state.m_snapshots[sender->getTag()].m_version;
+        m_historyInfo.m_state = m_historyInfo.m_restoreCallback(version);
+        updateList();
+    }
+
+public:
+    static HistoryPopup* create(HistoryInfo historyInfo) {
+        auto ret = new HistoryPopup();
+        if (ret && ret->init(historyInfo)) {
+            ret->autorelease();
+            return ret;
+        }
+        CC_SAFE_DELETE(ret);
+        return nullptr;
+    }
+};
@@ -0,0 +1,121 @@
+struct LayerFolder {
+    std::string m_name;
+    int m_first;
+    int m_last;
+    bool m_collapsed = false;
+
+    bool contains(int layer) const {
+        return layer >= m_first && layer <= m_last;
+    }
+};
+
+
+inline std::vector<LayerFolder> foldersFromJson(const matjson::Value& json) {
+    std::vector<LayerFolder> folders;
+    if (!json.isArray()) return folders;
+    for (auto& value : json) {
+        auto name = value["name"].asString();
+        auto first = value["from"].asInt();
+        auto last = value["to"].asInt();
+        if (!name || !first || !last) continue;
+        folders.push_back({*name, (int)*first, (int)*last, value["collapsed"].asBool().unwrapOr(false)});
+    }
+    return folders;
+}
+
+
+inline matjson::Value foldersToJson(const std::vector<LayerFolder>& folders) {
+    std::vector<matjson::Value> array;
+    for (const auto& folder : folders) {
+        matjson::Value value;
+        value["name"] = folder.m_name;
+        value["from"] = folder.m_first;
+        value["to"] = folder.m_last;
+        value["collapsed"] = folder.m_collapsed;
+        array.push_back(std::move(value));
+    }
+    return matjson::Value(std::move(array));
+}
+
+
+inline std::vector<LayerFolder> loadLayerFolders(GJGameLevel* level) {
+    bool useObject = Mod::get()->getSettingValue<bool>("use-save-object");
+    auto folders = SaveLevelDataAPI::getSavedValue(level, "folders", true, useObject);
+    return folders.isOk() ? foldersFromJson(*folders) : std::vector<LayerFolder>();
+}
+
+
+inline void saveLayerFolders(GJGameLevel* level, const std::vector<LayerFolder>& folders) {
+    bool useObject = Mod::get()->getSettingValue<bool>("use-save-object");
+    SaveLevelDataAPI::setSavedValue(level, "folders", foldersToJson(folders), true, useObject);
+}
+
+
+// folders follow their layers: a folder that moves as a whole keeps its size, a folder
+// that only gets its own layers back stays, otherwise (compact, a shift over its border)
+// it covers the new places of its used layers
+inline std::vector<LayerFolder> remapFolders(std::vector<LayerFolder> folders, const LayerRemapTable& table, const std::unordered_set<int>& usedLayers) {
+    if (!table.m_moveFolders) return folders;
+    for (auto& folder : folders) {
+        int offset = remapLayer(table, folder.m_first) - folder.m_first;
+        bool whole = true;
+        for (int layer = folder.m_first; layer <= folder.m_last && whole; layer++) {
+            whole = remapLayer(table, layer) == layer + offset;
+        }
+        if (whole) {
+            folder.m_first += offset;
+            folder.m_last += offset;
+            continue;
+        }
+        bool entered = false;
+        for (int layer = 0; layer < LAYER_COUNT && !entered; layer++) {
+            entered = !folder.contains(layer) && folder.contains(remapLayer(table, layer));
+        }
+        if (!entered) continue;
+        int first = LAYER_COUNT;
+        int last = -1;
+        for (int layer = folder.m_first; layer <= folder.m_last; layer++) {
+            if (!usedLayers.contains(layer)) continue;
+            int newLayer = remapLayer(table, layer);
+            first = std::min(first, newLayer);
+            last = std::max(last, newLayer);
+        }
+        if (first <= last) {
+            folder.m_first = first;
+            folder.m_last = last;
+        }
+    }
+    return folders;
+}
+
+
+// Fenwick tree of object counts over layer numbers, updated object by object by
+// the layer index; any range total is O(log n) without going through the layers
+class LayerCountTree {
+private:
+    std::vector<int> m_tree = std::vector<int>(LAYER_COUNT + 1, 0); // 1-based
+
+public:
+    void add(int layer, int delta) {
+        if (layer < 0 || layer >= LAYER_COUNT) return;
+        for (int i = layer + 1; i <= LAYER_COUNT; i += i & -i) {
+            m_tree[i] += delta;
+        }
+    }
+
+
+    // sum of [0, layer]
+    int prefix(int layer) const {
+        int sum = 0;
+        for (int i = std::min(layer + 1, LAYER_COUNT); i > 0; i -= i & -i) {
+            sum += m_tree[i];
+        }
+        return sum;
+    }
+
+
+    int range(int first, int last) const {
+        if (last < first) return 0;
+        return prefix(last) - prefix(first - 1);
+    }
+};
@@ -0,0 +1,249 @@
+// Append-only log of name changes, saved next to the names. Only {layer, new name}
+// is stored per change; checkpoints of the whole table are rebuilt when the history
+// is loaded, so any version is restored from the nearest checkpoint and a few entries
+class LayerHistory {
+public:
+    struct Entry {
+        int m_layer;
+        std::string m_name; // empty - the name was removed
+    };
+
+    struct Snapshot {
+        std::string m_label;
+        size_t m_version;
+    };
+
+private:
+    static constexpr size_t CHECKPOINT_INTERVAL = 32;
+
+    LayerNames m_base; // version 0
+    std::vector<Entry> m_log;
+    std::vector<Snapshot> m_snapshots;
+
+    // in memory only
+    LayerNames m_head; // names after the last entry
+    std::map<size_t, LayerNames> m_checkpoints;
+
+    struct Change {
+        int m_layer;
+        std::string m_oldName;
+        std::string m_newName;
+    };
+    // one undo step: a rename (one change) or a restore (all changed layers)
+    using Step = std::vector<Change>;
+    std::vector<Step> m_undo;
+    std::vector<Step> m_redo;
+    // the next rename of the same layer starts a new step
+    bool m_sealed = true;
+
+
+    static void applyEntry(LayerNames& names, const Entry& entry) {
+        if (entry.m_name.empty()) names.erase(entry.m_layer);
+        else names.insert_or_assign(entry.m_layer, entry.m_name);
+    }
+
+
+    std::string headName(int layer) const {
+        auto it = m_head.find(layer);
+        return (it != m_head.end()) ? it->second : std::string();
+    }
+
+
+    void updateCheckpoint() {
+        if (!m_log.empty() && m_log.size() % CHECKPOINT_INTERVAL == 0) {
+            m_checkpoints.insert_or_assign(m_log.size(), m_head);
+        }
+    }
+
+
+    void append(Entry entry) {
+        applyEntry(m_head, entry);
+        m_log.push_back(std::move(entry));
+        updateCheckpoint();
+    }
+
+
+    // changes from the head to names
+    Step diff(const LayerNames& names) const {
+        Step step;
+        for (const auto& [layer, name] : m_head) {
+            if (!names.contains(layer)) step.push_back({layer, name, ""});
+        }
+        for (const auto& [layer, name] : names) {
+            auto oldName = headName(layer);
+            if (oldName != name) step.push_back({layer, std::move(oldName), name});
+        }
+        return step;
+    }
+
+public:
+    // names that changed without the history (remap, batch apply) are added as entries
+    void sync(const LayerNames& names) {
+        auto step = diff(names);
+        for (const auto& change : step) {
+            append({change.m_layer, change.m_newName});
+        }
+        if (!step.empty()) {
+            // the old steps may refer to the layers that were moved
+            m_undo.clear();
+            m_redo.clear();
+            m_sealed = true;
+        }
+    }
+
+
+    void record(int layer, const std::string& name) {
+        auto oldName = headName(layer);
+        if (oldName == name) return;
+        if (!m_sealed && !m_undo.empty() && m_undo.back().size() == 1 && m_undo.back()[0].m_layer == layer) {
+            // the same rename continues (the name is typed letter by letter)
+            m_log.back().m_name = name;
+            m_undo.back()[0].m_newName = name;
+            applyEntry(m_head, m_log.back());
+            updateCheckpoint();
+        } else {
+            append({layer, name});
+            m_undo.push_back({{layer, oldName, name}});
+        }
+        m_redo.clear();
+        m_sealed = false;
+    }
+
+
+    void seal() {
+        m_sealed = true;
+    }
+
+
+    bool undo() {
+        if (m_undo.empty()) return false;
+        auto step = std::move(m_undo.back());
+        m_undo.pop_back();
+        for (auto it = step.rbegin(); it != step.rend(); ++it) {
+            append({it->m_layer, it->m_oldName});
+        }
+        m_redo.push_back(std::move(step));
+        m_sealed = true;
+        return true;
+    }
+
+
+    bool redo() {
+        if (m_redo.empty()) return false;
+        auto step = std::move(m_redo.back());
+        m_redo.pop_back();
+        for (const auto& change : step) {
+            append({change.m_layer, change.m_newName});
+        }
+        m_undo.push_back(std::move(step));
+        m_sealed = true;
+        return true;
+    }
+
+
+    bool canUndo() const { return !m_undo.empty(); }
+    bool canRedo() const { return !m_redo.empty(); }
+    size_t version() const { return m_log.size(); }
+    const LayerNames& head() const { return m_head; }
+    const std::vector<Snapshot>& snapshots() const { return m_snapshots; }
+
+
+    void takeSnapshot(std::string label) {
+        m_sealed = true;
+        m_snapshots.push_back({std::move(label), m_log.size()});
+    }
+
+
+    // nearest checkpoint + at most CHECKPOINT_INTERVAL entries
+    LayerNames namesAt(size_t version) const {
+        version = std::min(version, m_log.size());
+        size_t start = 0;
+        LayerNames names = m_base;
+        auto it = m_checkpoints.upper_bound(version);
+        if (it != m_checkpoints.begin()) {
+            --it;
+            start = it->first;
+            names = it->second;
+        }
+        for (size_t i = start; i < version; i++) {
+            applyEntry(names, m_log[i]);
+        }
+        return names;
+    }
+
+
+    // appends the difference, so the restore itself is a new version
+    // and one undo step (the older steps stay)
+    bool restore(size_t version) {
+        auto step = diff(namesAt(version));
+        if (step.empty()) return false;
+        for (const auto& change : step) {
+            append({change.m_layer, change.m_newName});
+        }
+        m_undo.push_back(std::move(step));
+        m_redo.clear();
+        m_sealed = true;
+        return true;
+    }
+
+
+    matjson::Value toJson() const {
+        std::vector<matjson::Value> log;
+        for (const auto& entry : m_log) {
+            log.push_back(matjson::Value(std::vector<matjson::Value>{entry.m_layer, entry.m_name}));
+        }
+        std::vector<matjson::Value> snapshots;
+        for (const auto& snapshot : m_snapshots) {
+            snapshots.push_back(matjson::Value(std::vector<matjson::Value>{snapshot.m_label, (int64_t)snapshot.m_version}));
+        }
+        matjson::Value json;
+        json["base"] = layerNamesToJson(m_base);
+        json["log"] = matjson::Value(std::move(log));
+        json["snap"] = matjson::Value(std::move(snapshots));
+        return json;
+    }
+
+
+    // names - the current names of the level
+    static LayerHistory fromJson(const matjson::Value& json, const LayerNames& names) {
+        LayerHistory history;
+        if (!json.isObject()) {
+            history.m_base = names;
+            history.m_head = names;
+            return history;
+        }
+        history.m_base = layerNamesFromJson(json["base"]);
+        history.m_head = history.m_base;
+        if (json["log"].isArray()) {
+            for (auto& value : json["log"]) {
+                auto layer = value[0].asInt();
+                auto name = value[1].asString();
+                if (!layer || !name) continue;
+                history.append({(int)*layer, *name});
+            }
+        }
+        if (json["snap"].isArray()) {
+            for (auto& value : json["snap"]) {
+                auto label = value[0].asString();
+                auto version = value[1].asInt();
+                if (!label || !version) continue;
+                history.m_snapshots.push_back({*label, (size_t)*version});
+            }
+        }
+        history.sync(names);
+        return history;
+    }
+};
+
+
+inline LayerHistory loadLayerHistory(GJGameLevel* level, const LayerNames& names) {
+    bool useObject = Mod::get()->getSettingValue<bool>("use-save-object");
+    auto history = SaveLevelDataAPI::getSavedValue(level, "layers-history", true, useObject);
+    return LayerHistory::fromJson(history.isOk() ? *history : matjson::Value(), names);
+}
+
+
+inline void saveLayerHistory(GJGameLevel* level, const LayerHistory& history) {
+    bool useObject = Mod::get()->getSettingValue<bool>("use-save-object");
+    SaveLevelDataAPI::setSavedValue(level, "layers-history", history.toJson(), true, useObject);
+}
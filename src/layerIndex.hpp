@@ -0,0 +1,160 @@
+// Objects of every layer, shared by the layer list and the API. It is kept current
+// object by object (added, removed, layers changed), so nothing is rescanned when
+// the level changes; reconcile() is the full check for changes made past the hooks
+class LayerIndex {
+private:
+    struct Tracked {
+        Ref<GameObject> m_object; // a removed object is never handed out dangling
+        int m_layer1;
+        int m_layer2; // -1 - no second layer
+        unsigned int m_generation;
+    };
+
+    std::unordered_map<GameObject*, Tracked> m_tracked;
+    std::unordered_map<int, std::unordered_set<GameObject*>> m_objects;
+    // layers whose count changed since the last takeChangedLayers
+    std::unordered_set<int> m_changedLayers;
+    unsigned int m_generation = 0;
+
+    // for the folder totals: objects by layer 1 and by layer 2,
+    // and {lower, higher} layers of the objects that have two layers
+    LayerCountTree m_layer1Counts;
+    LayerCountTree m_layer2Counts;
+    std::map<std::pair<int, int>, int> m_pairs;
+
+
+    static int secondLayer(GameObject* obj) {
+        int layer2 = obj->m_editorLayer2;
+        return (layer2 > 0 && layer2 != obj->m_editorLayer) ? layer2 : -1;
+    }
+
+
+    void link(GameObject* obj, int layer) {
+        if (layer == -1) return;
+        m_objects[layer].insert(obj);
+        m_changedLayers.insert(layer);
+    }
+
+
+    void unlink(GameObject* obj, int layer) {
+        if (layer == -1) return;
+        auto it = m_objects.find(layer);
+        if (it == m_objects.end()) return;
+        it->second.erase(obj);
+        if (it->second.empty()) m_objects.erase(it);
+        m_changedLayers.insert(layer);
+    }
+
+
+    void countObject(int layer1, int layer2, int delta) {
+        m_layer1Counts.add(layer1, delta);
+        if (layer2 == -1) return;
+        m_layer2Counts.add(layer2, delta);
+        auto key = std::make_pair(std::min(layer1, layer2), std::max(layer1, layer2));
+        if ((m_pairs[key] += delta) == 0) m_pairs.erase(key);
+    }
+
+
+    // the object's layers are compared with the ones it was indexed with
+    void move(GameObject* obj, Tracked& tracked) {
+        int layer1 = obj->m_editorLayer;
+        int layer2 = secondLayer(obj);
+        if (layer1 == tracked.m_layer1 && layer2 == tracked.m_layer2) return;
+        unlink(obj, tracked.m_layer1);
+        unlink(obj, tracked.m_layer2);
+        countObject(tracked.m_layer1, tracked.m_layer2, -1);
+        link(obj, layer1);
+        link(obj, layer2);
+        countObject(layer1, layer2, 1);
+        tracked.m_layer1 = layer1;
+        tracked.m_layer2 = layer2;
+    }
+
+public:
+    void add(GameObject* obj) {
+        auto it = m_tracked.find(obj);
+        if (it != m_tracked.end()) {
+            move(obj, it->second);
+            return;
+        }
+        int layer1 = obj->m_editorLayer;
+        int layer2 = secondLayer(obj);
+        m_tracked.insert({obj, {obj, layer1, layer2, m_generation}});
+        link(obj, layer1);
+        link(obj, layer2);
+        countObject(layer1, layer2, 1);
+    }
+
+
+    void remove(GameObject* obj) {
+        auto it = m_tracked.find(obj);
+        if (it == m_tracked.end()) return;
+        unlink(obj, it->second.m_layer1);
+        unlink(obj, it->second.m_layer2);
+        countObject(it->second.m_layer1, it->second.m_layer2, -1);
+        m_tracked.erase(it);
+    }
+
+
+    // the layers of the object could be changed
+    void update(GameObject* obj) {
+        auto it = m_tracked.find(obj);
+        if (it != m_tracked.end()) move(obj, it->second);
+    }
+
+
+    // one pass over the level: adds the missing objects, moves the changed ones
+    // and drops the ones that are not in the level anymore
+    void reconcile(CCArray* objects) {
+        m_generation++;
+        for (auto* obj : CCArrayExt<GameObject*>(objects)) {
+            add(obj);
+            m_tracked.at(obj).m_generation = m_generation;
+        }
+        std::vector<GameObject*> removed;
+        for (const auto& [obj, tracked] : m_tracked) {
+            if (tracked.m_generation != m_generation) removed.push_back(obj);
+        }
+        for (auto* obj : removed) {
+            remove(obj);
+        }
+    }
+
+
+    int count(int layer) const {
+        auto it = m_objects.find(layer);
+        return (it != m_objects.end()) ? (int)it->second.size() : 0;
+    }
+
+
+    // objects with a layer in [first, last]; an object with both layers in the range counts once
+    int rangeCount(int first, int last) const {
+        int total = m_layer1Counts.range(first, last) + m_layer2Counts.range(first, last);
+        auto it = m_pairs.lower_bound({first, std::numeric_limits<int>::min()});
+        for (; it != m_pairs.end() && it->first.first <= last; ++it) {
+            if (it->first.second <= last) total -= it->second;
+        }
+        return total;
+    }
+
+
+    std::unordered_map<int, int> counts() const {
+        std::unordered_map<int, int> result;
+        for (const auto& [layer, layerObjects] : m_objects) {
+            result.insert({layer, (int)layerObjects.size()});
+        }
+        return result;
+    }
+
+
+    std::vector<GameObject*> objects(int layer) const {
+        auto it = m_objects.find(layer);
+        if (it == m_objects.end()) return {};
+        return std::vector<GameObject*>(it->second.begin(), it->second.end());
+    }
+
+
+    std::unordered_set<int> takeChangedLayers() {
+        return std::exchange(m_changedLayers, {});
+    }
+};
@@ -1,8 +1,17 @@
 struct LayersInfo {
     std::unordered_map<int, int> m_layersToInclude;
-    std::unordered_map<int, std::string> *m_layerNames;
+    LayerNameTable::Snapshot m_layerNames;
     int m_currentLayer;
-    std::function<void(int layer, const char* name)> m_updateCallback;
+    // returns the updated names
+    std::function<LayerNameTable::Snapshot(int layer, const char* name)> m_updateCallback;
+    std::function<void(const LayerRemapTable& table)> m_remapCallback;
+    std::vector<LayerFolder> m_folders;
+    std::function<void(const std::vector<LayerFolder>& folders)> m_foldersCallback;
+    // objects in a range of layers, each object counted once
+    std::function<int(int first, int last)> m_rangeCountCallback;
+    std::function<void()> m_historyCallback;
+    // a rename starts, so it is a new history step
+    std::function<void()> m_renameStartCallback;
 };
 
 
@@ -12,6 +21,11 @@ private:
     const float m_height = 280.f;
 
     LayersInfo m_layersInfo;
+    // sorted {layer, object count}
+    std::vector<std::pair<int, int>> m_layers;
+
+    ScrollLayer* m_scroll = nullptr;
+    Scrollbar* m_scrollbar = nullptr;
 
 protected:
     bool init(LayersInfo layerInfo) {
@@ -32,10 +46,26 @@ protected:
             "Use the <cy>lock</c> button to lock/unlock the layer.\n"
             "Use the <cy>plus</c> button to change layer name.\n"
             "Use the <cy>go to layer</c> button to jump to that layer.\n"
+            "Use the <cy>folder</c> button to group a range of layers.\n"
             "<cg>You can also change the name of the layer by CLICKING ON "
             "ITS TEXT directly in the editor!</c>", 0.75);
         menu->addChildAtPosition(infoBtn, Anchor::TopRight, ccp(-18, -18));
 
+        auto remapSpr = ButtonSprite::create("Remap", "bigFont.fnt", "GJ_button_04.png", 0.8);
+        remapSpr->setScale(0.45);
+        auto remapBtn = CCMenuItemSpriteExtra::create(remapSpr, this, menu_selector(LayerListPopup::onRemapButton));
+        menu->addChildAtPosition(remapBtn, Anchor::TopLeft, ccp(40, -18));
+
+        auto folderSpr = ButtonSprite::create("Folder", "bigFont.fnt", "GJ_button_04.png", 0.8);
+        folderSpr->setScale(0.45);
+        auto folderBtn = CCMenuItemSpriteExtra::create(folderSpr, this, menu_selector(LayerListPopup::onNewFolderButton));
+        menu->addChildAtPosition(folderBtn, Anchor::TopLeft, ccp(95, -18));
+
+        auto historySpr = ButtonSprite::create("History", "bigFont.fnt", "GJ_button_04.png", 0.8);
+        historySpr->setScale(0.45);
+        auto historyBtn = CCMenuItemSpriteExtra::create(historySpr, this, menu_selector(LayerListPopup::onHistoryButton));
+        menu->addChildAtPosition(historyBtn, Anchor::TopRight, ccp(-68, -18));
+
         setupScrollLayer();
         setID("layer-list-popup"_spr);
         return true;
@@ -43,88 +73,215 @@ protected:
 
 
     void setupScrollLayer() {
+        m_scroll = ScrollLayer::create({m_width - 40, m_height - 55});
+        m_mainLayer->addChild(m_scroll);
+        m_scroll->setPosition({20,20});
+
+        m_scrollbar = Scrollbar::create(m_scroll);
+        m_scrollbar->setPosition(m_scroll->getPosition() + m_scroll->getContentSize() + ccp(3,0));
+        m_scrollbar->setAnchorPoint({0,1});
+        m_scrollbar->setScaleX(1.15);
+        m_mainLayer->addChild(m_scrollbar, 5);
+
+        auto border = ListBorders::create();
+        border->setSpriteFrames("GJ_commentTop_001.png", "GJ_commentSide_001.png");
+        m_scroll->addChild(border, 3);
+        border->setContentSize(m_scroll->getContentSize());
+        border->setPosition(m_scroll->getContentSize() / 2);
+
+        m_layers.assign(m_layersInfo.m_layersToInclude.begin(), m_layersInfo.m_layersToInclude.end());
+        std::sort(m_layers.begin(), m_layers.end(), [](std::pair<int, int> a, std::pair<int, int> b){return a.first < b.first;});
+
+        rebuildList();
+        m_scroll->scrollToTop();
+    }
+
+
+    // the innermost folder of the layer: folders are sorted by start and then by size,
+    // so a nested folder comes after the folders that contain it
+    int folderOf(int layer) {
+        for (int i = (int)m_layersInfo.m_folders.size() - 1; i >= 0; i--) {
+            if (m_layersInfo.m_folders[i].contains(layer)) return i;
+        }
+        return -1;
+    }
+
+
+    // rebuilds the rows from the sorted layers and the folders, objects aren't scanned
+    void rebuildList() {
+        const float cellHeight = 25;
+        auto content = m_scroll->m_contentLayer;
+        float scrollHeight = m_scroll->getContentHeight();
+        float offsetFromTop = content->getPositionY() - (scrollHeight - content->getContentHeight());
+        content->removeAllChildren();
+
+        auto& folders = m_layersInfo.m_folders;
+        std::sort(folders.begin(), folders.end(), [](const LayerFolder& a, const LayerFolder& b){
+            if (a.m_first != b.m_first) return a.m_first < b.m_first;
+            return a.m_last > b.m_last;
+        });
+
+        // entries of every folder (the last one - top level): child folders and layers
+        std::vector<std::vector<std::pair<int, int>>> entries(folders.size() + 1); // {position, folder index or -1 - layer index}
+        auto entriesOf = [&](int folder) -> auto& { return entries[folder == -1 ? folders.size() : folder]; };
+        std::vector<int> parents; // folders that contain the current one
+        for (int i = 0; i < (int)folders.size(); i++) {
+            while (!parents.empty() && !(folders[parents.back()].contains(folders[i].m_first) && folders[parents.back()].contains(folders[i].m_last))) {
+                parents.pop_back();
+            }
+            entriesOf(parents.empty() ? -1 : parents.back()).push_back({folders[i].m_first, i});
+            parents.push_back(i);
+        }
+        for (int i = 0; i < (int)m_layers.size(); i++) {
+            entriesOf(folderOf(m_layers[i].first)).push_back({m_layers[i].first, -1 - i});
+        }
+
+        int btnCount = 0;
+        std::function<void(int, float)> addRows = [&](int folder, float indent) {
+            auto& items = entriesOf(folder);
+            std::stable_sort(items.begin(), items.end(), [](std::pair<int, int> a, std::pair<int, int> b){
+                if (a.first != b.first) return a.first < b.first;
+                return a.second > b.second; // folder first
+            });
+            for (auto [pos, idx] : items) {
+                if (idx < 0) {
+                    auto [layer, objCount] = m_layers[-1 - idx];
+                    content->addChild(createLayerCell(layer, objCount, btnCount++, indent));
+                    continue;
+                }
+                content->addChild(createFolderCell(idx, indent));
+                btnCount++;
+                if (!folders[idx].m_collapsed) addRows(idx, indent + 12);
+            }
+        };
+        addRows(-1, 0);
+
+        content->setContentHeight(std::max(cellHeight * btnCount, scrollHeight));
+        content->setLayout(ColumnLayout::create()->setAutoScale(false)->setAxisReverse(true)->setGap(0)->setCrossAxisLineAlignment(AxisAlignment::Start)->setAxisAlignment(AxisAlignment::End));
+        float minY = scrollHeight - content->getContentHeight();
+        content->setPositionY(std::clamp(minY + offsetFromTop, minY, 0.f));
+        m_scrollbar->setVisible(cellHeight * btnCount > scrollHeight);
+    }
+
+
+    CCNode* createFolderCell(int folderIdx, float indent) {
         const float cellHeight = 25;
         const float cellWidth = m_width - 40;
+        auto& folder = m_layersInfo.m_folders[folderIdx];
+
+        auto cell = CCLayerColor::create(ccc4(110,60,30,255), cellWidth, cellHeight);
 
-        auto scroll = ScrollLayer::create({m_width - 40, m_height - 55});
-        m_mainLayer->addChild(scroll);
-        scroll->setPosition({20,20});
+        auto menu = CCMenu::create();
+        cell->addChild(menu);
+        menu->setContentSize(cell->getContentSize());
+        menu->setPosition(cell->getContentSize() / 2.f);
+
+        auto arrowSpr = CCSprite::createWithSpriteFrameName("edit_upBtn_001.png");
+        arrowSpr->setScale(0.6);
+        arrowSpr->setFlipY(!folder.m_collapsed);
+        auto arrowBtn = CCMenuItemSpriteExtra::create(arrowSpr, this, menu_selector(LayerListPopup::onFolderToggle));
+        arrowBtn->setTag(folderIdx);
+        menu->addChildAtPosition(arrowBtn, Anchor::Left, ccp(14 + indent, 0));
+
+        auto nameLab = CCLabelBMFont::create(fmt::format("{} ({}-{})", folder.m_name, folder.m_first, folder.m_last).c_str(), "goldFont.fnt");
+        nameLab->setAnchorPoint({0,0.5});
+        nameLab->limitLabelWidth(180 - indent, 0.55, 0);
+        cell->addChildAtPosition(nameLab, Anchor::Left, ccp(30 + indent, 0));
+
+        auto countLab = CCLabelBMFont::create(fmt::format("Obj: {}", m_layersInfo.m_rangeCountCallback(folder.m_first, folder.m_last)).c_str(), "chatFont.fnt");
+        countLab->setAnchorPoint({0,0.5});
+        countLab->limitLabelWidth(40, 0.6, 0);
+        cell->addChildAtPosition(countLab, Anchor::Right, ccp(-135, 0));
+
+        auto deleteSpr = CCSprite::createWithSpriteFrameName("GJ_deleteIcon_001.png");
+        deleteSpr->setScale(0.55);
+        auto deleteBtn = CCMenuItemSpriteExtra::create(deleteSpr, this, menu_selector(LayerListPopup::onFolderDelete));
+        deleteBtn->setTag(folderIdx);
+        menu->addChildAtPosition(deleteBtn, Anchor::Right, ccp(-25, 0));
+
+        return cell;
+    }
 
-        std::vector<std::pair<int, int>> layers(m_layersInfo.m_layersToInclude.begin(), m_layersInfo.m_layersToInclude.end());
-        std::sort(layers.begin(), layers.end(), [](std::pair<int, int> a, std::pair<int, int> b){return a.first < b.first;});
+
+    CCNode* createLayerCell(int layer, int objCount, int btnCount, float indent) {
+        const float cellHeight = 25;
+        const float cellWidth = m_width - 40;
 
         auto editor = LevelEditorLayer::get();
         bool isLockingEnabled = editor->m_layerLockingEnabled;
 
-        int btnCount = 0;
-        for (auto [layer, objCount] : layers) {
-            auto cell = CCLayerColor::create(btnCount % 2 ? ccc4(161,88,44,255) : ccc4(194,114,62,255), cellWidth, cellHeight);
-
-            auto indexLab = CCLabelBMFont::create(fmt::format("{}.", layer).c_str(), "bigFont.fnt");
-            indexLab->limitLabelWidth(25, 0.5, 0);
-            indexLab->setAnchorPoint({0,0.5});
-            cell->addChildAtPosition(indexLab, Anchor::Left, ccp(10, 0));
-
-            auto it = m_layersInfo.m_layerNames->find(layer);
-            auto name = (it != m_layersInfo.m_layerNames->end()) ? it->second : std::string("");
-            auto nameLab = CCLabelBMFont::create((name == "") ? "-" : name.c_str(), "bigFont.fnt");
-            nameLab->setAnchorPoint({0,0.5});
-            nameLab->limitLabelWidth(150, 0.5, 0);
-            cell->addChildAtPosition(nameLab, Anchor::Left, ccp(45, 0));
-
-            auto menu = CCMenu::create();
-            cell->addChild(menu);
-            menu->setContentSize(cell->getContentSize());
-            menu->setPosition(cell->getContentSize() / 2.f);
-
-            auto gotoSpr = CCSprite::createWithSpriteFrameName("GJ_goToLayerBtn_001.png");
-            gotoSpr->setScale(0.63);
-            auto gotoBtn = CCMenuItemSpriteExtra::create(gotoSpr, this, menu_selector(LayerListPopup::onGoToLayerButton));
-            gotoBtn->setTag(layer);
-            menu->addChildAtPosition(gotoBtn, Anchor::Right, ccp(-25, 0));
-
-            auto plusSpr = CCSprite::createWithSpriteFrameName("GJ_plus2Btn_001.png");
-            plusSpr->setScale(0.73);
-            auto plusBtn = CCMenuItemSpriteExtra::create(plusSpr, this, menu_selector(LayerListPopup::onPlusButton));
-            plusBtn->setTag(layer);
-            plusBtn->setUserObject(nameLab);
-            menu->addChildAtPosition(plusBtn, Anchor::Right, ccp(-51, 0));
-
-            if (isLockingEnabled) {
-                auto lockBtn = CCMenuItemToggler::createWithSize("GJ_lockGray_001.png", "GJ_lock_001.png", this, menu_selector(LayerListPopup::onLockButton), 0.55f);
-                lockBtn->setTag(layer);
-                static_cast<CCSprite*>(lockBtn->m_offButton->getNormalImage())->setOpacity(90);
-                menu->addChildAtPosition(lockBtn, Anchor::Right, ccp(-73, 0));
-                lockBtn->toggle(editor->isLayerLocked(layer));
-            }
+        auto cell = CCLayerColor::create(btnCount % 2 ? ccc4(161,88,44,255) : ccc4(194,114,62,255), cellWidth, cellHeight);
 
-            auto countLab = CCLabelBMFont::create(fmt::format("Obj: {}", objCount).c_str(), "chatFont.fnt");
-            countLab->setAnchorPoint({0,0.5});
-            countLab->limitLabelWidth(40, 0.6, 0);
-            countLab->setColor(ccc3(86,48,14));
-            cell->addChildAtPosition(countLab, Anchor::Right, ccp(-135, 0));
+        auto indexLab = CCLabelBMFont::create(fmt::format("{}.", layer).c_str(), "bigFont.fnt");
+        indexLab->limitLabelWidth(25, 0.5, 0);
+        indexLab->setAnchorPoint({0,0.5});
+        cell->addChildAtPosition(indexLab, Anchor::Left, ccp(10 + indent, 0));
 
-            scroll->m_contentLayer->addChild(cell);
-            btnCount++;
-        }
+        auto it = m_layersInfo.m_layerNames->find(layer);
+        auto name = (it != m_layersInfo.m_layerNames->end()) ? it->second : std::string("");
+        auto nameLab = CCLabelBMFont::create((name == "") ? "-" : name.c_str(), "bigFont.fnt");
+        nameLab->setAnchorPoint({0,0.5});
+        nameLab->limitLabelWidth(150 - indent, 0.5, 0);
+        cell->addChildAtPosition(nameLab, Anchor::Left, ccp(45 + indent, 0));
 
-        scroll->m_contentLayer->setContentHeight(std::max(cellHeight * btnCount, scroll->getContentHeight()));
-        scroll->m_contentLayer->setLayout(ColumnLayout::create()->setAutoScale(false)->setAxisReverse(true)->setGap(0)->setCrossAxisLineAlignment(AxisAlignment::Start)->setAxisAlignment(AxisAlignment::End));
-        scroll->scrollToTop();
-        
-        if (cellHeight * btnCount > scroll->getContentHeight()) {
-            auto bar = Scrollbar::create(scroll);
-            bar->setPosition(scroll->getPosition() + scroll->getContentSize() + ccp(3,0));
-            bar->setAnchorPoint({0,1});
-            bar->setScaleX(1.15);
-            m_mainLayer->addChild(bar, 5);
+        auto menu = CCMenu::create();
+        cell->addChild(menu);
+        menu->setContentSize(cell->getContentSize());
+        menu->setPosition(cell->getContentSize() / 2.f);
+
+        auto gotoSpr = CCSprite::createWithSpriteFrameName("GJ_goToLayerBtn_001.png");
+        gotoSpr->setScale(0.63);
+        auto gotoBtn = CCMenuItemSpriteExtra::create(gotoSpr, this, menu_selector(LayerListPopup::onGoToLayerButton));
+        gotoBtn->setTag(layer);
+        menu->addChildAtPosition(gotoBtn, Anchor::Right, ccp(-25, 0));
+
+        auto plusSpr = CCSprite::createWithSpriteFrameName("GJ_plus2Btn_001.png");
+        plusSpr->setScale(0.73);
+        auto plusBtn = CCMenuItemSpriteExtra::create(plusSpr, this, menu_selector(LayerListPopup::onPlusButton));
+        plusBtn->setTag(layer);
+        plusBtn->setUserObject(nameLab);
+        menu->addChildAtPosition(plusBtn, Anchor::Right, ccp(-51, 0));
+
+        if (isLockingEnabled) {
+            auto lockBtn = CCMenuItemToggler::createWithSize("GJ_lockGray_001.png", "GJ_lock_001.png", this, menu_selector(LayerListPopup::onLockButton), 0.55f);
+            lockBtn->setTag(layer);
+            static_cast<CCSprite*>(lockBtn->m_offButton->getNormalImage())->setOpacity(90);
+            menu->addChildAtPosition(lockBtn, Anchor::Right, ccp(-73, 0));
+            lockBtn->toggle(editor->isLayerLocked(layer));
         }
 
-        auto border = ListBorders::create();
-        border->setSpriteFrames("GJ_commentTop_001.png", "GJ_commentSide_001.png");
-        scroll->addChild(border, 3);
-        border->setContentSize(scroll->getContentSize());
-        border->setPosition(scroll->getContentSize() / 2);
+        auto countLab = CCLabelBMFont::create(fmt::format("Obj: {}", objCount).c_str(), "chatFont.fnt");
+        countLab->setAnchorPoint({0,0.5});
+        countLab->limitLabelWidth(40, 0.6, 0);
+        countLab->setColor(ccc3(86,48,14));
+        cell->addChildAtPosition(countLab, Anchor::Right, ccp(-135, 0));
+
+        return cell;
+    }
+
+
+    void onFolderToggle(CCObject* sender) {
+        auto& folder = m_layersInfo.m_folders[sender->getTag()];
+        folder.m_collapsed = !folder.m_collapsed;
+        m_layersInfo.m_foldersCallback(m_layersInfo.m_folders);
+        rebuildList();
+    }
+
+
+    void onFolderDelete(CCObject* sender) {
+        auto& folders = m_layersInfo.m_folders;
+        folders.erase(folders.begin() + sender->getTag());
+        m_layersInfo.m_foldersCallback(folders);
+        rebuildList();
+    }
+
+
+    void onNewFolderButton(CCObject*) {
+        FolderPopup::create(m_layersInfo.m_folders, [this] (LayerFolder folder) {
+            m_layersInfo.m_folders.push_back(std::move(folder));
+            m_layersInfo.m_foldersCallback(m_layersInfo.m_folders);
+            rebuildList();
+        })->show();
     }
 
 
@@ -142,11 +299,12 @@ protected:
         int layer = sender->getTag();
         auto it = m_layersInfo.m_layerNames->find(layer);
         auto name = (it != m_layersInfo.m_layerNames->end()) ? it->second : std::string("");
+        m_layersInfo.m_renameStartCallback();
         SetNamePopup::create({
             layer, name,
             [this, lab] (int layer, const char* name) {
                 if (layer == -1) return;
-                m_layersInfo.m_updateCallback(layer, name);
+                m_layersInfo.m_layerNames = m_layersInfo.m_updateCallback(layer, name);
                 lab->setString((*name == '\0') ? "-" : name);
                 lab->limitLabelWidth(150, 0.5, 0);
             }
@@ -154,6 +312,33 @@ protected:
     }
 
 
+    void onHistoryButton(CCObject*) {
+        // the list is outdated after going through the history
+        auto callback = m_layersInfo.m_historyCallback;
+        onClose(nullptr);
+        callback();
+    }
+
+
+    void onRemapButton(CCObject*) {
+        std::vector<int> usedLayers;
+        for (auto [layer, objCount] : m_layersInfo.m_layersToInclude) {
+            if (objCount > 0 || m_layersInfo.m_layerNames->contains(layer)) {
+                usedLayers.push_back(layer);
+            }
+        }
+        RemapPopup::create({
+            std::move(usedLayers),
+            [this] (const LayerRemapTable& table) {
+                // the list is outdated after the remap
+                auto callback = m_layersInfo.m_remapCallback;
+                onClose(nullptr);
+                callback(table);
+            }
+        })->show();
+    }
+
+
     void onLockButton(CCObject* sender) {
         auto editor = LevelEditorLayer::get();
         int layer = sender->getTag();
@@ -0,0 +1,144 @@
+using LayerNames = std::unordered_map<int, std::string>;
+
+
+inline LayerNames layerNamesFromJson(const matjson::Value& json) {
+    LayerNames names;
+    if (!json.isObject()) return names;
+    for (auto& [key, value] : json) {
+        if (value.isString()) {
+            names.insert({std::atoi(key.c_str()), *value.asString()});
+        }
+    }
+    return names;
+}
+
+
+inline matjson::Value layerNamesToJson(const LayerNames& names) {
+    matjson::Value jsonVal;
+    for (const auto& [key, value] : names) {
+        jsonVal[std::to_string(key)] = value;
+    }
+    return jsonVal;
+}
+
+
+// reads the names of the level (from the Save Level Data API or from the old save)
+inline LayerNames loadLayerNames(GJGameLevel* level, bool useObject) {
+    auto layers = SaveLevelDataAPI::getSavedValue(level, "layers", true, useObject);
+    if (layers.isOk() && layers->isObject()) {
+        // saved by the mod, even if empty (all names were removed or replaced)
+        return layerNamesFromJson(*layers);
+    }
+
+    // todo: deprecated, exists only to recover old saves
+    LayerNames names;
+    int levelId = EditorIDs::getID(level);
+    if (auto res = matjson::parse(Mod::get()->getSavedValue<std::string>(std::to_string(levelId), "{}"))) {
+        names = layerNamesFromJson(*res);
+    }
+    return names;
+}
+
+
+inline LayerNames loadLayerNames(GJGameLevel* level) {
+    return loadLayerNames(level, Mod::get()->getSettingValue<bool>("use-save-object"));
+}
+
+
+// The name table is published as immutable snapshots. Writers (main thread only) copy
+// the current version, change the copy and publish it; readers on any thread take the
+// current snapshot under a short lock (only the pointer is copied) and keep it alive
+// as long as they need
+class LayerNameTable {
+public:
+    using Snapshot = std::shared_ptr<const LayerNames>;
+
+private:
+    mutable std::mutex m_mutex;
+    Snapshot m_current = std::make_shared<const LayerNames>();
+    std::atomic<uint64_t> m_version{0};
+
+    void publish(Snapshot names) {
+        {
+            std::lock_guard lock(m_mutex);
+            m_current.swap(names);
+        }
+        // the old table (now in names) is released outside of the lock
+        m_version++;
+    }
+
+public:
+    Snapshot snapshot() const {
+        std::lock_guard lock(m_mutex);
+        return m_current;
+    }
+
+
+    // increases with every published change
+    uint64_t version() const {
+        return m_version.load();
+    }
+
+
+    // copy-on-write update: fn receives a private copy of the current table
+    template <class F>
+    void update(F&& fn) {
+        auto copy = std::make_shared<LayerNames>(*snapshot());
+        fn(*copy);
+        publish(std::move(copy));
+    }
+
+
+    void assign(LayerNames names) {
+        publish(std::make_shared<const LayerNames>(std::move(names)));
+    }
+
+
+    void set(int layer, std::string name) {
+        update([&](LayerNames& names) {
+            names.insert_or_assign(layer, std::move(name));
+        });
+    }
+
+
+    void erase(int layer) {
+        if (!snapshot()->contains(layer)) return;
+        update([&](LayerNames& names) {
+            names.erase(layer);
+        });
+    }
+};
+
+
+// names of the levels outside of the editor, by level ID
+inline std::unordered_map<int, LayerNameTable::Snapshot>& layerNamesCache() {
+    static std::unordered_map<int, LayerNameTable::Snapshot> cache;
+    return cache;
+}
+
+
+// increased when the saved data of the level changes,
+// the level scans that were started before are outdated (see levelScan.hpp)
+inline std::unordered_map<int, unsigned int>& levelDataGenerations() {
+    static std::unordered_map<int, unsigned int> generations;
+    return generations;
+}
+
+
+inline void invalidateLayerNames(int levelId) {
+    layerNamesCache().erase(levelId);
+    levelDataGenerations()[levelId]++;
+}
+
+
+inline void saveLayerNames(GJGameLevel* level, const LayerNames& names) {
+    bool useObject = Mod::get()->getSettingValue<bool>("use-save-object");
+    int levelId = EditorIDs::getID(level);
+    invalidateLayerNames(levelId);
+    SaveLevelDataAPI::setSavedValue(level, "layers", layerNamesToJson(names), true, useObject);
+    // the old save must not bring the names back
+    auto legacyKey = std::to_string(levelId);
+    if (Mod::get()->hasSavedValue(legacyKey)) {
+        Mod::get()->getSaveContainer().erase(legacyKey);
+    }
+}
@@ -0,0 +1,117 @@
+// Names of the layers around the current one. The labels are a ring buffer:
+// moving by one layer changes the text of only one label, the others just move
+class LayerPreviewStrip : public CCNode {
+private:
+    int m_radius = 0; // layers on each side
+    float m_slotWidth = 0;
+    std::vector<CCLabelBMFont*> m_labels;
+    int m_head = 0; // label of the leftmost layer (current - radius)
+    int m_current = 0;
+    bool m_filled = false;
+    LayerNameTable::Snapshot m_names;
+
+protected:
+    bool init(int radius, float width) {
+        if (!CCNode::init()) return false;
+
+        m_radius = radius;
+        int size = 2 * radius + 1;
+        m_slotWidth = width / size;
+        setContentSize({width, 10});
+
+        for (int i = 0; i < size; i++) {
+            auto lab = CCLabelBMFont::create("", "chatFont.fnt");
+            lab->setPositionY(5);
+            addChild(lab);
+            m_labels.push_back(lab);
+        }
+        return true;
+    }
+
+
+    void setSlotText(CCLabelBMFont* lab, int layer) {
+        if (layer < 0) {
+            lab->setString("");
+            return;
+        }
+        auto it = m_names->find(layer);
+        if (it != m_names->end()) {
+            lab->setString(it->second.c_str());
+            lab->setColor(ccc3(255,255,255));
+        } else {
+            lab->setString(fmt::format("{}", layer).c_str());
+            lab->setColor(ccc3(150,150,150));
+        }
+        lab->limitLabelWidth(m_slotWidth - 4, 0.6, 0);
+    }
+
+
+    void updatePositions() {
+        int size = m_labels.size();
+        for (int k = 0; k < size; k++) {
+            auto lab = m_labels[(m_head + k) % size];
+            lab->setPositionX(m_slotWidth * (k + 0.5f));
+            // the current layer is shown by the main label
+            lab->setVisible(k != m_radius);
+        }
+    }
+
+
+    void fill(int layer) {
+        m_current = layer;
+        m_head = 0;
+        for (int k = 0; k < (int)m_labels.size(); k++) {
+            setSlotText(m_labels[k], layer - m_radius + k);
+        }
+        m_filled = true;
+    }
+
+public:
+    static LayerPreviewStrip* create(int radius, float width) {
+        auto ret = new LayerPreviewStrip();
+        if (ret && ret->init(radius, width)) {
+            ret->autorelease();
+            return ret;
+        }
+        CC_SAFE_DELETE(ret);
+        return nullptr;
+    }
+
+
+    void setLayer(int layer, LayerNameTable::Snapshot names) {
+        m_names = std::move(names);
+        int size = m_labels.size();
+        if (!m_filled || std::abs(layer - m_current) >= size) {
+            fill(layer);
+        } else {
+            while (m_current < layer) {
+                // the leftmost label becomes the rightmost one
+                setSlotText(m_labels[m_head], m_current + 1 + m_radius);
+                m_head = (m_head + 1) % size;
+                m_current++;
+            }
+            while (m_current > layer) {
+                // the rightmost label becomes the leftmost one
+                m_head = (m_head + size - 1) % size;
+                setSlotText(m_labels[m_head], m_current - 1 - m_radius);
+                m_current--;
+            }
+        }
+        updatePositions();
+    }
+
+
+    // names changed
+    void refresh(LayerNameTable::Snapshot names) {
+        if (!m_filled) return;
+        m_names = std::move(names);
+        fill(m_current);
+        updatePositions();
+    }
+
+
+    // the next setLayer fills all labels again
+    void reset() {
+        m_filled = false;
+    }
+};
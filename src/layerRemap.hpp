@@ -0,0 +1,100 @@
+// same limit as the lock array of the editor
+constexpr int LAYER_COUNT = 10000;
+
+struct LayerRemapTable {
+    // dense lookup table: old layer -> new layer
+    std::vector<int> m_layers;
+    // merge leaves the folders in place, the other remaps move them with their layers
+    bool m_moveFolders = true;
+};
+
+
+inline LayerRemapTable identityRemap() {
+    LayerRemapTable table{std::vector<int>(LAYER_COUNT)};
+    std::iota(table.m_layers.begin(), table.m_layers.end(), 0);
+    return table;
+}
+
+
+inline LayerRemapTable mergeRemap(int from, int to) {
+    auto table = identityRemap();
+    table.m_layers[from] = to;
+    table.m_moveFolders = false;
+    return table;
+}
+
+
+// moves layers [first, last] by offset; the layers in the way take the freed
+// place in the same order, so no two layers end up merged
+inline LayerRemapTable shiftRemap(int first, int last, int offset) {
+    auto table = identityRemap();
+    for (int layer = first; layer <= last; layer++) {
+        table.m_layers[layer] = layer + offset;
+    }
+    std::vector<int> displaced;
+    for (int layer = first + offset; layer <= last + offset; layer++) {
+        if (layer < first || layer > last) displaced.push_back(layer);
+    }
+    std::vector<int> freed;
+    for (int layer = first; layer <= last; layer++) {
+        if (layer < first + offset || layer > last + offset) freed.push_back(layer);
+    }
+    for (size_t i = 0; i < displaced.size(); i++) {
+        table.m_layers[displaced[i]] = freed[i];
+    }
+    return table;
+}
+
+
+// makes used layers contiguous, layer 0 always stays in place
+inline LayerRemapTable compactRemap(std::vector<int> usedLayers) {
+    auto table = identityRemap();
+    std::sort(usedLayers.begin(), usedLayers.end());
+    int next = 1;
+    for (int layer : usedLayers) {
+        if (layer <= 0 || layer >= LAYER_COUNT) continue;
+        table.m_layers[layer] = next++;
+    }
+    return table;
+}
+
+
+inline int remapLayer(const LayerRemapTable& table, int layer) {
+    return (layer >= 0 && layer < (int)table.m_layers.size()) ? table.m_layers[layer] : layer;
+}
+
+
+// names move with their layers; the name of the target layer is kept (merge A into B
+// keeps the name of B), a moved name is used only if the target has none
+inline LayerNames remapNames(const LayerNames& names, const LayerRemapTable& table) {
+    LayerNames result;
+    for (const auto& [layer, name] : names) {
+        if (remapLayer(table, layer) == layer) result.insert({layer, name});
+    }
+    for (const auto& [layer, name] : names) {
+        int newLayer = remapLayer(table, layer);
+        if (newLayer != layer) result.insert({newLayer, name});
+    }
+    return result;
+}
+
+
+struct LayerFolder; // layerFolders.hpp
+
+
+// everything needed to revert one remap
+struct RemapUndo {
+    struct ObjectLayers {
+        Ref<GameObject> object;
+        int layer1;
+        int layer2;
+    };
+    std::vector<ObjectLayers> m_objects;
+    LayerNameTable::Snapshot m_names;
+    std::vector<bool> m_locked;
+    std::vector<LayerFolder> m_folders;
+    // state of the editor undo list right after the remap,
+    // the remap is the last action while it stays the same
+    unsigned int m_undoCount;
+    CCObject* m_lastUndo;
+};
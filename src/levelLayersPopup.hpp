@@ -0,0 +1,117 @@
+class LevelLayersPopup : public Popup {
+private:
+    const float m_width = 300.f;
+    const float m_height = 280.f;
+
+    Ref<GJGameLevel> m_level;
+    LayerNameTable::Snapshot m_layerNames;
+    CCLabelBMFont* m_usedLab = nullptr;
+
+protected:
+    bool init(GJGameLevel* level) {
+        if (!Popup::init(m_width, m_height))
+            return false;
+
+        m_level = level;
+        setTitle("Named Layers");
+
+        auto menu = CCMenu::create();
+        menu->setContentSize(m_mainLayer->getContentSize());
+        m_mainLayer->addChildAtPosition(menu, Anchor::Center);
+
+        auto infoBtn = InfoAlertButton::create("Help", "The list of named layers of the level. Use the <cy>apply</c> button to copy them to other levels", 0.75);
+        menu->addChildAtPosition(infoBtn, Anchor::TopRight, ccp(-18, -18));
+
+        m_usedLab = CCLabelBMFont::create("Used layers: ...", "chatFont.fnt");
+        m_usedLab->setScale(0.7);
+        m_mainLayer->addChildAtPosition(m_usedLab, Anchor::Top, ccp(0, -40));
+
+        auto applySpr = ButtonSprite::create("Apply to levels", "goldFont.fnt", "GJ_button_01.png", 0.8);
+        applySpr->setScale(0.6);
+        auto applyBtn = CCMenuItemSpriteExtra::create(applySpr, this, menu_selector(LevelLayersPopup::onApplyButton));
+        menu->addChildAtPosition(applyBtn, Anchor::Bottom, ccp(0, 22));
+
+        setID("level-layers-popup"_spr);
+
+        // the popup is kept alive until the level is scanned
+        Ref<LevelLayersPopup> self = this;
+        requestLevelSummary(level, [self](const LevelSummary& summary) {
+            self->onSummary(summary);
+        });
+        return true;
+    }
+
+
+    void onSummary(const LevelSummary& summary) {
+        m_layerNames = summary.m_names;
+        setTitle(fmt::format("Named Layers: {}", m_layerNames->size()));
+        m_usedLab->setString(fmt::format("Used layers: {}", summary.m_usedLayers).c_str());
+        setupScrollLayer();
+    }
+
+
+    void setupScrollLayer() {
+        const float cellHeight = 25;
+        const float cellWidth = m_width - 40;
+
+        auto scroll = ScrollLayer::create({m_width - 40, m_height - 100});
+        m_mainLayer->addChild(scroll);
+        scroll->setPosition({20,45});
+
+        std::vector<std::pair<int, std::string>> layers(m_layerNames->begin(), m_layerNames->end());
+        std::sort(layers.begin(), layers.end(), [](const std::pair<int, std::string>& a, const std::pair<int, std::string>& b){return a.first < b.first;});
+
+        int btnCount = 0;
+        for (auto& [layer, name] : layers) {
+            auto cell = CCLayerColor::create(btnCount % 2 ? ccc4(161,88,44,255) : ccc4(194,114,62,255), cellWidth, cellHeight);
+
+            auto indexLab = CCLabelBMFont::create(fmt::format("{}.", layer).c_str(), "bigFont.fnt");
+            indexLab->limitLabelWidth(25, 0.5, 0);
+            indexLab->setAnchorPoint({0,0.5});
+            cell->addChildAtPosition(indexLab, Anchor::Left, ccp(10, 0));
+
+            auto nameLab = CCLabelBMFont::create(name.c_str(), "bigFont.fnt");
+            nameLab->setAnchorPoint({0,0.5});
+            nameLab->limitLabelWidth(190, 0.5, 0);
+            cell->addChildAtPosition(nameLab, Anchor::Left, ccp(45, 0));
+
+            scroll->m_contentLayer->addChild(cell);
+            btnCount++;
+        }
+
+        scroll->m_contentLayer->setContentHeight(std::max(cellHeight * btnCount, scroll->getContentHeight()));
+        scroll->m_contentLayer->setLayout(ColumnLayout::create()->setAutoScale(false)->setAxisReverse(true)->setGap(0)->setCrossAxisLineAlignment(AxisAlignment::Start)->setAxisAlignment(AxisAlignment::End));
+        scroll->scrollToTop();
+
+        if (cellHeight * btnCount > scroll->getContentHeight()) {
+            auto bar = Scrollbar::create(scroll);
+            bar->setPosition(scroll->getPosition() + scroll->getContentSize() + ccp(3,0));
+            bar->setAnchorPoint({0,1});
+            bar->setScaleX(1.15);
+            m_mainLayer->addChild(bar, 5);
+        }
+
+        auto border = ListBorders::create();
+        border->setSpriteFrames("GJ_commentTop_001.png", "GJ_commentSide_001.png");
+        scroll->addChild(border, 3);
+        border->setContentSize(scroll->getContentSize());
+        border->setPosition(scroll->getContentSize() / 2);
+    }
+
+
+    void onApplyButton(CCObject*) {
+        if (!m_layerNames) return; // not read yet
+        BatchApplyPopup::create(m_level, m_layerNames)->show();
+    }
+
+public:
+    static LevelLayersPopup* create(GJGameLevel* level) {
+        auto ret = new LevelLayersPopup();
+        if (ret && ret->init(level)) {
+            ret->autorelease();
+            return ret;
+        }
+        CC_SAFE_DELETE(ret);
+        return nullptr;
+    }
+};
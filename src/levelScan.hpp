@@ -0,0 +1,188 @@
+// What the level page shows about a saved level: its layer names and the number of
+// editor layers that have objects. Both come from one pass over the level string on a
+// separate thread: the pass counts the layers and, with the save object, picks the names
+// out of it; when only the names are missing, it stops at the save object. The results
+// are cached by level ID until the level is saved again
+inline std::unordered_map<int, int>& usedLayersCache() {
+    static std::unordered_map<int, int> cache;
+    return cache;
+}
+
+
+struct LevelSummary {
+    LayerNameTable::Snapshot m_names;
+    int m_usedLayers;
+};
+
+
+// scans that are still running (main thread only)
+struct PendingLevelScan {
+    Ref<GJGameLevel> m_level;
+    std::vector<std::function<void(const LevelSummary&)>> m_callbacks;
+};
+
+
+inline std::unordered_map<int, PendingLevelScan>& pendingLevelScans() {
+    static std::unordered_map<int, PendingLevelScan> scans;
+    return scans;
+}
+
+
+struct LevelScanResult {
+    int m_usedLayers = -1; // -1 - not counted
+    std::optional<matjson::Value> m_names; // the names of the save object
+};
+
+
+// the values of the save object are kept by the mod ID
+inline std::optional<matjson::Value> namesFromSaveObject(std::string_view text, const std::string& modId) {
+    auto json = matjson::parse(std::string(ZipUtils::base64URLDecode(std::string(text))));
+    if (!json || !json->isObject()) return std::nullopt;
+    auto& values = json->contains(modId) ? (*json)[modId] : *json;
+    if (!values.isObject() || !values.contains("layers") || !values["layers"].isObject()) return std::nullopt;
+    return values["layers"];
+}
+
+
+// one pass over the decoded level string: "header;key,value,key,value...;..."
+// key 1 is the object ID (914 - text), 20 - editor layer, 61 - editor layer 2, 31 - text
+inline LevelScanResult scanLevelString(std::string_view data, bool countLayers, bool findNames, const std::string& modId) {
+    LevelScanResult result;
+    std::vector<bool> used(LAYER_COUNT, false);
+    int count = 0;
+    auto mark = [&](int layer) {
+        if (layer < 0 || layer >= LAYER_COUNT || used[layer]) return;
+        used[layer] = true;
+        count++;
+    };
+    auto toInt = [](std::string_view token) {
+        int value = 0;
+        std::from_chars(token.data(), token.data() + token.size(), value);
+        return value;
+    };
+
+    size_t pos = data.find(';');
+    if (pos == std::string_view::npos) return result;
+    pos++; // the level header is not an object
+    while (pos < data.size()) {
+        size_t end = data.find(';', pos);
+        if (end == std::string_view::npos) end = data.size();
+        if (end > pos) {
+            int layer1 = 0;
+            int layer2 = 0;
+            bool isText = false;
+            std::string_view text;
+            bool isKey = true;
+            std::string_view key;
+            size_t i = pos;
+            while (i <= end) {
+                size_t comma = data.find(',', i);
+                if (comma == std::string_view::npos || comma > end) comma = end;
+                auto token = data.substr(i, comma - i);
+                if (isKey) key = token;
+                else if (key == "1") isText = (token == "914");
+                else if (key == "20") layer1 = toInt(token);
+                else if (key == "61") layer2 = toInt(token);
+                else if (key == "31") text = token;
+                isKey = !isKey;
+                i = comma + 1;
+            }
+            if (countLayers) {
+                mark(layer1);
+                if (layer2 > 0) mark(layer2);
+            }
+            if (findNames && isText && !text.empty()) {
+                if ((result.m_names = namesFromSaveObject(text, modId))) {
+                    findNames = false;
+                    // the rest of the level is needed only for the count
+                    if (!countLayers) break;
+                }
+            }
+        }
+        pos = end + 1;
+    }
+    if (countLayers) result.m_usedLayers = count;
+    return result;
+}
+
+
+inline void startLevelScan(int levelId);
+
+
+// main thread, after the scan
+inline void finishLevelScan(int levelId, unsigned int generation, LevelScanResult result) {
+    auto it = pendingLevelScans().find(levelId);
+    if (it == pendingLevelScans().end()) return;
+    if (levelDataGenerations()[levelId] != generation) {
+        // the level was saved while it was scanned
+        return startLevelScan(levelId);
+    }
+
+    auto level = it->second.m_level;
+    if (result.m_usedLayers != -1) {
+        usedLayersCache().insert_or_assign(levelId, result.m_usedLayers);
+    }
+    auto& namesCache = layerNamesCache();
+    if (!namesCache.contains(levelId)) {
+        // without the save object (or if it's not there) the names are in the mod save, no decoding needed
+        auto names = result.m_names ? layerNamesFromJson(*result.m_names) : loadLayerNames(level, false);
+        namesCache.insert({levelId, std::make_shared<const LayerNames>(std::move(names))});
+    }
+
+    LevelSummary summary{namesCache.at(levelId), usedLayersCache().at(levelId)};
+    auto callbacks = std::move(it->second.m_callbacks);
+    pendingLevelScans().erase(it);
+    for (auto& callback : callbacks) {
+        callback(summary);
+    }
+}
+
+
+inline void startLevelScan(int levelId) {
+    auto level = pendingLevelScans().at(levelId).m_level;
+    unsigned int generation = levelDataGenerations()[levelId];
+    bool countLayers = !usedLayersCache().contains(levelId);
+    bool findNames = Mod::get()->getSettingValue<bool>("use-save-object") && !layerNamesCache().contains(levelId);
+    if (!countLayers && !findNames) {
+        return finishLevelScan(levelId, generation, {});
+    }
+
+    std::string levelString = level->m_levelString;
+    std::string modId = Mod::get()->getID();
+    std::thread([=, levelString = std::move(levelString)] {
+        // local levels are stored compressed
+        std::string data = levelString.starts_with("H4sI")
+            ? std::string(ZipUtils::decompressString(levelString, false, 0))
+            : levelString;
+        auto result = scanLevelString(data, countLayers, findNames, modId);
+        queueInMainThread([=, result = std::move(result)] {
+            finishLevelScan(levelId, generation, std::move(result));
+        });
+    }).detach();
+}
+
+
+// calls back on the main thread, immediately if everything is cached
+inline void requestLevelSummary(GJGameLevel* level, std::function<void(const LevelSummary&)> callback) {
+    int levelId = EditorIDs::getID(level);
+    auto names = layerNamesCache().find(levelId);
+    auto used = usedLayersCache().find(levelId);
+    if (names != layerNamesCache().end() && used != usedLayersCache().end()) {
+        callback({names->second, used->second});
+        return;
+    }
+
+    auto& scan = pendingLevelScans()[levelId];
+    scan.m_callbacks.push_back(std::move(callback));
+    if (scan.m_callbacks.size() > 1) return; // already scanning
+    scan.m_level = level;
+    startLevelScan(levelId);
+}
+
+
+// the objects of the level changed
+inline void invalidateUsedLayers(GJGameLevel* level) {
+    int levelId = EditorIDs::getID(level);
+    usedLayersCache().erase(levelId);
+    levelDataGenerations()[levelId]++;
+}
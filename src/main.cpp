@@ -5,24 +5,79 @@
 #include <Geode/modify/SetGroupIDLayer.hpp>
 #include <Geode/modify/GJGameLevel.hpp>
 #include <Geode/modify/EditorUI.hpp>
+#include <Geode/modify/EditLevelLayer.hpp>
+#include <Geode/modify/LevelEditorLayer.hpp>
 #include <Geode/utils/general.hpp>
 #include <unordered_map>
+#include <unordered_set>
 #include <matjson.hpp>
 #include <matjson/std.hpp>
 #include <algorithm>
+#include <chrono>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <map>
+#include <limits>
+#include <thread>
+#include <charconv>
+#include <string_view>
+#include "../include/NamedEditorLayers.hpp"
+#include "apiBridge.hpp"
 
 using namespace geode::prelude;
 
+#include "layerNames.hpp"
+#include "layerRemap.hpp"
+#include "layerFolders.hpp"
+#include "layerPreviewStrip.hpp"
+#include "layerHistory.hpp"
+#include "layerIndex.hpp"
 #include "setNamePopup.hpp"
+#include "remapPopup.hpp"
+#include "folderPopup.hpp"
+#include "historyPopup.hpp"
 #include "layerListPopup.hpp"
 #include "simpleSelectPopup.hpp"
+#include "levelScan.hpp"
+#include "batchApplyPopup.hpp"
+#include "levelLayersPopup.hpp"
+
+
+class $modify(MyLevelEditorLayer, LevelEditorLayer) {
+	struct Fields {
+		// objects of every layer, filled while the level is loaded
+		LayerIndex index;
+	};
+
+	// every object that is added to or removed from the editor goes through these
+	void addSpecial(GameObject* obj) {
+		LevelEditorLayer::addSpecial(obj);
+		m_fields->index.add(obj);
+	}
+
+
+	void removeSpecial(GameObject* obj) {
+		LevelEditorLayer::removeSpecial(obj);
+		m_fields->index.remove(obj);
+	}
+};
 
 
 class $modify(MyEditorUI, EditorUI) {
 	struct Fields {
-		std::unordered_map<int, std::string> layerNames;
+		LayerNameTable layerNames;
 		Ref<CCLabelBMFont> layerNameLabel;
 		Ref<CCMenu> layerMenu;
+		Ref<LayerPreviewStrip> previewStrip;
+		std::vector<RemapUndo> remapUndos;
+		std::vector<LayerFolder> folders;
+		LayerHistory history;
+		// the state that the API listeners know
+		LayerNameTable::Snapshot notifiedNames;
+		std::unordered_map<int, int> notifiedCounts;
 	};
 
 	static void onModify(auto& self) {
@@ -55,6 +110,16 @@ class $modify(MyEditorUI, EditorUI) {
 
 		m_fields->layerNameLabel = label;
 		m_fields->layerMenu = menu;
+
+		if (Mod::get()->getSettingValue<bool>("layer-preview-strip")) {
+			auto strip = LayerPreviewStrip::create(2, 150);
+			strip->setID("preview-strip"_spr);
+			strip->setAnchorPoint({1,1});
+			strip->setScale(menu->getScale());
+			strip->setPosition(menu->getPosition() - ccp(0, menu->getScaledContentHeight()));
+			addChild(strip, 6);
+			m_fields->previewStrip = strip;
+		}
 	}
 
 
@@ -71,6 +136,8 @@ class $modify(MyEditorUI, EditorUI) {
 
 
 	void checkLayer(float) {
+		checkSelection();
+		flushChanges();
 		static int layer = -500;
 		if (m_editorLayer->m_currentLayer == layer) return;
 		// layer changed
@@ -79,12 +146,84 @@ class $modify(MyEditorUI, EditorUI) {
 	}
 
 
+	// other mods (BetterEdit inputs, selection tools) write the layers of the selected
+	// objects directly, so the selection is compared with the index every frame
+	void checkSelection() {
+		auto& index = layerIndex();
+		if (m_selectedObject) index.update(m_selectedObject);
+		if (m_selectedObjects) {
+			for (auto* obj : CCArrayExt<GameObject*>(m_selectedObjects)) {
+				index.update(obj);
+			}
+		}
+	}
+
+
+	// sends the changes of this frame to the API listeners
+	void flushChanges() {
+		auto& listeners = api_bridge::changesListeners();
+		auto f = m_fields.self();
+		// only the layers changed by this frame are checked
+		auto changedLayers = layerIndex().takeChangedLayers();
+		named_layers::LayerChanges changes{f->layerNames.version()};
+
+		auto names = f->layerNames.snapshot();
+		if (names != f->notifiedNames) {
+			static const LayerNames noNames;
+			auto& oldNames = f->notifiedNames ? *f->notifiedNames : noNames;
+			for (const auto& [layer, name] : oldNames) {
+				if (!names->contains(layer)) changes.m_names.push_back({layer, ""});
+			}
+			for (const auto& [layer, name] : *names) {
+				auto it = oldNames.find(layer);
+				if (it == oldNames.end() || it->second != name) changes.m_names.push_back({layer, name});
+			}
+			f->notifiedNames = names;
+		}
+
+		for (int layer : changedLayers) {
+			int count = layerIndex().count(layer);
+			auto it = f->notifiedCounts.find(layer);
+			int oldCount = (it != f->notifiedCounts.end()) ? it->second : 0;
+			if (count == oldCount) continue;
+			changes.m_counts.push_back({layer, count});
+			if (count) f->notifiedCounts.insert_or_assign(layer, count);
+			else f->notifiedCounts.erase(layer);
+		}
+
+		// the state is tracked without listeners too, so a new listener gets only the later changes
+		if (listeners.empty() || (changes.m_names.empty() && changes.m_counts.empty())) return;
+		// a listener may remove itself
+		auto listenersCopy = listeners;
+		for (auto& [id, callback] : listenersCopy) {
+			callback(changes);
+		}
+	}
+
+
+	LayerIndex& layerIndex() {
+		return reinterpret_cast<MyLevelEditorLayer*>(m_editorLayer)->m_fields->index;
+	}
+
+
+	std::unordered_map<int, int> layerCounts() {
+		return layerIndex().counts();
+	}
+
+
+	std::vector<GameObject*> layerObjects(int layer) {
+		return layerIndex().objects(layer);
+	}
+
+
 	void updateLayerText(int layer) {
+		updatePreviewStrip(layer);
 		if (layer == -1) { // all
 			updateLabel("");
 		} else {
-			auto it = m_fields->layerNames.find(layer);
-			if (it != m_fields->layerNames.end()) {
+			auto names = m_fields->layerNames.snapshot();
+			auto it = names->find(layer);
+			if (it != names->end()) {
 				updateLabel(it->second.c_str());
 			} else {
 				updateLabel(" - ");
@@ -93,6 +232,26 @@ class $modify(MyEditorUI, EditorUI) {
 	}
 
 
+	void updatePreviewStrip(int layer) {
+		auto strip = m_fields->previewStrip;
+		if (!strip) return;
+		if (layer == -1) { // all
+			strip->setVisible(false);
+			strip->reset();
+		} else {
+			strip->setVisible(m_fields->layerMenu->isVisible());
+			strip->setLayer(layer, m_fields->layerNames.snapshot());
+		}
+	}
+
+
+	void refreshPreviewStrip() {
+		if (auto strip = m_fields->previewStrip) {
+			strip->refresh(m_fields->layerNames.snapshot());
+		}
+	}
+
+
 	void freeUpSomeSpace() {
 		auto bigMenu = getChildByID("editor-buttons-menu");
 		auto topRight = bigMenu->getPosition() + ccp(bigMenu->getScaledContentWidth() * (1 - bigMenu->getAnchorPoint().x), bigMenu->getScaledContentHeight() * (1 - bigMenu->getAnchorPoint().y));
@@ -131,29 +290,11 @@ class $modify(MyEditorUI, EditorUI) {
 		if (!EditorUI::init(editor))
 			return false;
 
-		auto f = m_fields.self();
-		int levelId = EditorIDs::getID(editor->m_level);
-
-		bool useObject = Mod::get()->getSettingValue<bool>("use-save-object");
-		auto layers = SaveLevelDataAPI::getSavedValue(editor->m_level, "layers", true, useObject);
-		if (layers.isOk() && (*layers).isObject()) {
-			for (auto& [key, value] : *layers) {
-				if (value.isString()) {
-					f->layerNames.insert({std::atoi(key.c_str()), *value.asString()});
-				}
-			}
-		}
-
-		// todo: deprecated, exists only to recover old saves
-		if (f->layerNames.empty()) {
-			if (auto res = matjson::parse(Mod::get()->getSavedValue<std::string>(std::to_string(levelId), "{}"))) {
-				for (auto& [key, value] : *res) {
-					if (value.isString()) {
-						f->layerNames.insert({std::atoi(key.c_str()), *value.asString()});
-					}
-				}
-			}
-		}
+		m_fields->layerNames.assign(loadLayerNames(editor->m_level));
+		m_fields->history = loadLayerHistory(editor->m_level, *m_fields->layerNames.snapshot());
+		m_fields->folders = loadLayerFolders(editor->m_level);
+		// the objects that were loaded without going through addSpecial
+		layerIndex().reconcile(editor->m_objects);
 		
 		if (getChildByID("editor-buttons-menu")->getScale() > 0.85) {
 			freeUpSomeSpace();
@@ -172,43 +313,40 @@ class $modify(MyEditorUI, EditorUI) {
 	void showUI(bool b) {
 		EditorUI::showUI(b);
 		m_fields->layerMenu->setVisible(b);
+		if (auto strip = m_fields->previewStrip) {
+			strip->setVisible(b && m_editorLayer->m_currentLayer != -1);
+		}
 	}
 
 
 	void nameUpdated(int layer, const char* name) {
 		if (layer == -1) return;
+		m_fields->history.record(layer, name ? name : "");
 		if (name == nullptr || *name == '\0') {
 			m_fields->layerNames.erase(layer);
 			if (m_editorLayer->m_currentLayer == layer) {
 				updateLabel(" - ");
 			}
 		} else {
-			m_fields->layerNames.insert_or_assign(layer, name);
+			m_fields->layerNames.set(layer, name);
 			if (m_editorLayer->m_currentLayer == layer) {
 				updateLabel(name);
 			}
 		}
+		refreshPreviewStrip();
 	}
 
 
 	void onLayerListButton(CCObject*) {
+		m_fields->history.seal();
 		auto editor = LevelEditorLayer::get();
-		auto allObjects = editor->m_objects;
-		std::unordered_map<int, int> layerCountMap;
-		// layers with objects
-		for (auto* obj : CCArrayExt<GameObject*>(allObjects)) {
-			auto it = layerCountMap.find(obj->m_editorLayer);
-			if (it != layerCountMap.end()) it->second++;
-			else layerCountMap.insert({obj->m_editorLayer, 1});
-
-			if (obj->m_editorLayer2 != obj->m_editorLayer && obj->m_editorLayer2 > 0) {
-				it = layerCountMap.find(obj->m_editorLayer2);
-				if (it != layerCountMap.end()) it->second++;
-				else layerCountMap.insert({obj->m_editorLayer2, 1});						
-			}
-		}
+		// layers with objects; other mods can change the layers without the hooks,
+		// so the index is checked against the level (one pass, as the list always did)
+		layerIndex().reconcile(m_editorLayer->m_objects);
+		auto layerCountMap = layerCounts();
 		// layers that are named
-		for (auto const &layer : m_fields->layerNames) {
+		auto names = m_fields->layerNames.snapshot();
+		for (auto const &layer : *names) {
 			layerCountMap.insert({layer.first, 0});
 		}
 		// current layer
@@ -216,18 +354,189 @@ class $modify(MyEditorUI, EditorUI) {
 		
 		LayerListPopup::create({
 			std::move(layerCountMap),
-			&m_fields->layerNames,
+			names,
 			m_editorLayer->m_currentLayer,
-			[this] (int layer, const char* name) {nameUpdated(layer, name);}
+			[this] (int layer, const char* name) {
+				nameUpdated(layer, name);
+				return m_fields->layerNames.snapshot();
+			},
+			[this] (const LayerRemapTable& table) {
+				applyRemap(table);
+				onLayerListButton(nullptr);
+			},
+			m_fields->folders,
+			[this] (const std::vector<LayerFolder>& folders) {
+				m_fields->folders = folders;
+			},
+			[this] (int first, int last) {
+				return layerIndex().rangeCount(first, last);
+			},
+			[this] () {
+				onHistoryButton(nullptr);
+			},
+			[this] () {
+				m_fields->history.seal();
+			}
 		})->show();
 	}
 
 
+	void onHistoryButton(CCObject*) {
+		// the names could be changed by the remap
+		m_fields->history.sync(*m_fields->layerNames.snapshot());
+		HistoryPopup::create({
+			historyState(),
+			[this] () {
+				if (m_fields->history.undo()) historyChanged();
+				return historyState();
+			},
+			[this] () {
+				if (m_fields->history.redo()) historyChanged();
+				return historyState();
+			},
+			[this] (std::string label) {
+				m_fields->history.takeSnapshot(std::move(label));
+				return historyState();
+			},
+			[this] (size_t version) {
+				if (m_fields->history.restore(version)) historyChanged();
+				return historyState();
+			}
+		})->show();
+	}
+
+
+	HistoryState historyState() {
+		auto& history = m_fields->history;
+		return {history.version(), history.snapshots()};
+	}
+
+
+	// the history changed the names
+	void historyChanged() {
+		m_fields->layerNames.assign(m_fields->history.head());
+		updateLayerText(m_editorLayer->m_currentLayer);
+		refreshPreviewStrip();
+	}
+
+
+	// rewrites the layers of all objects in one pass
+	void applyRemap(const LayerRemapTable& table) {
+		RemapUndo undo;
+		// layers with objects or names, before the remap
+		std::unordered_set<int> usedLayers;
+		for (const auto& [layer, count] : layerCounts()) {
+			usedLayers.insert(layer);
+		}
+		for (const auto& [layer, name] : *m_fields->layerNames.snapshot()) {
+			usedLayers.insert(layer);
+		}
+
+		for (auto* obj : CCArrayExt<GameObject*>(m_editorLayer->m_objects)) {
+			int l1 = obj->m_editorLayer;
+			int l2 = obj->m_editorLayer2;
+			int newL1 = remapLayer(table, l1);
+			int newL2 = (l2 > 0) ? remapLayer(table, l2) : l2;
+			if (newL1 == l1 && newL2 == l2) continue;
+			undo.m_objects.push_back({obj, l1, l2});
+			obj->m_editorLayer = newL1;
+			obj->m_editorLayer2 = newL2;
+			layerIndex().update(obj);
+		}
+
+		// names
+		undo.m_names = m_fields->layerNames.snapshot();
+		m_fields->layerNames.assign(remapNames(*undo.m_names, table));
+
+		// folders
+		undo.m_folders = m_fields->folders;
+		m_fields->folders = remapFolders(m_fields->folders, table, usedLayers);
+
+		// lock state
+		undo.m_locked.resize(LAYER_COUNT);
+		for (int layer = 0; layer < LAYER_COUNT; layer++) {
+			undo.m_locked[layer] = m_editorLayer->isLayerLocked(layer);
+		}
+		for (int layer = 0; layer < LAYER_COUNT; layer++) {
+			m_editorLayer->m_lockedLayers[layer] = false;
+		}
+		for (int layer = 0; layer < LAYER_COUNT; layer++) {
+			if (!undo.m_locked[layer]) continue;
+			int newLayer = remapLayer(table, layer);
+			if (newLayer >= 0 && newLayer < LAYER_COUNT) {
+				m_editorLayer->m_lockedLayers[newLayer] = true;
+			}
+		}
+
+		// one undo step, the remap holds references to the objects so only a few are kept
+		auto undoList = m_editorLayer->m_undoObjects;
+		undo.m_undoCount = undoList->count();
+		undo.m_lastUndo = undoList->lastObject();
+		auto& undos = m_fields->remapUndos;
+		undos.push_back(std::move(undo));
+		if (undos.size() > 5) undos.erase(undos.begin());
+
+		// the next rename is recorded against the remapped names
+		m_fields->history.sync(*m_fields->layerNames.snapshot());
+		updateLayerText(m_editorLayer->m_currentLayer);
+		refreshPreviewStrip();
+	}
+
+
+	void revertRemap(RemapUndo& undo) {
+		for (auto& [obj, l1, l2] : undo.m_objects) {
+			obj->m_editorLayer = l1;
+			obj->m_editorLayer2 = l2;
+			layerIndex().update(obj);
+		}
+		m_fields->layerNames.assign(*undo.m_names);
+		m_fields->folders = undo.m_folders;
+		for (int layer = 0; layer < LAYER_COUNT; layer++) {
+			m_editorLayer->m_lockedLayers[layer] = undo.m_locked[layer];
+		}
+		m_fields->history.sync(*m_fields->layerNames.snapshot());
+		updateLayerText(m_editorLayer->m_currentLayer);
+		refreshPreviewStrip();
+	}
+
+
+	void undoLastAction(CCObject* sender) {
+		auto& undos = m_fields->remapUndos;
+		auto undoList = m_editorLayer->m_undoObjects;
+		// the remap is the last action if nothing was added to the undo list after it
+		if (!undos.empty() && undos.back().m_undoCount == undoList->count() && undos.back().m_lastUndo == undoList->lastObject()) {
+			revertRemap(undos.back());
+			undos.pop_back();
+			return;
+		}
+		EditorUI::undoLastAction(sender);
+		// undo can bring back the old layers of the objects
+		layerIndex().reconcile(m_editorLayer->m_objects);
+	}
+
+
+	void redoLastAction(CCObject* sender) {
+		EditorUI::redoLastAction(sender);
+		layerIndex().reconcile(m_editorLayer->m_objects);
+	}
+
+
+	void onPasteState(CCObject* sender) {
+		EditorUI::onPasteState(sender);
+		// the layers are pasted too
+		for (auto* obj : CCArrayExt<GameObject*>(getSelectedObjects())) {
+			layerIndex().update(obj);
+		}
+	}
+
+
 	void onTextClick(CCObject*) {
 		int layer = m_editorLayer->m_currentLayer;
 		if (layer == -1) return;
-		auto it = m_fields->layerNames.find(layer);
-		auto name = (it != m_fields->layerNames.end()) ? it->second : std::string();
+		m_fields->history.seal();
+		auto names = m_fields->layerNames.snapshot();
+		auto it = names->find(layer);
+		auto name = (it != names->end()) ? it->second : std::string();
 		SetNamePopup::create({layer, name,
 			[this] (int layer, const char* name) {nameUpdated(layer, name);}
 		})->show();
@@ -251,6 +560,15 @@ class $modify(MySetGroupIDLayer, SetGroupIDLayer) {
 			CCNode* unmix1{};
 			CCNode* unmix2{};
 		} betterEdit;
+
+		// {layer, object count} of the selection, collected once and then kept current
+		std::unordered_map<int, int> summaryL1;
+		std::unordered_map<int, int> summaryL2;
+		int selectionSize = 0;
+
+		// the objects whose layers may change
+		Ref<GameObject> editedObject;
+		Ref<CCArray> editedObjects;
 	};
 
 
@@ -284,6 +602,8 @@ class $modify(MySetGroupIDLayer, SetGroupIDLayer) {
 
 	bool init(GameObject* obj, CCArray* objects) {
 		if (!SetGroupIDLayer::init(obj, objects)) return false;
+		m_fields->editedObject = obj;
+		m_fields->editedObjects = objects;
 
 		if (!Mod::get()->getSettingValue<bool>("in-edit-groups-menu")) {
 			return true;
@@ -299,14 +619,8 @@ class $modify(MySetGroupIDLayer, SetGroupIDLayer) {
 			m_fields->betterEdit.inputL2 = menuL2->getChildByType<TextInput>(0);
 			m_fields->betterEdit.unmix1 = menuL1->getChildByID("hjfod.betteredit/unmix-button");
 			m_fields->betterEdit.unmix2 = menuL2->getChildByID("hjfod.betteredit/unmix-button");
-			if (obj) {
-				m_fields->betterEdit.objects.push_back(obj);
-			} else {
-				for (auto obj : CCArrayExt<GameObject*>(objects)) {
-					m_fields->betterEdit.objects.push_back(obj);
-				}
-			}
 		}
+		collectSelection(obj, objects);
 
 		// best idea how to fix overlapping
 		if (Loader::get()->isModLoaded("spaghettdev.named-editor-groups")) {
@@ -337,6 +651,34 @@ class $modify(MySetGroupIDLayer, SetGroupIDLayer) {
 	}
 
 
+	// one pass over the selection
+	void collectSelection(GameObject* obj, CCArray* objects) {
+		auto f = m_fields.self();
+		auto add = [f](GameObject* obj) {
+			f->summaryL1[obj->m_editorLayer]++;
+			// 0 means the object has no layer 2
+			if (obj->m_editorLayer2 > 0) f->summaryL2[obj->m_editorLayer2]++;
+			f->selectionSize++;
+			if (f->isBetterEdit) f->betterEdit.objects.push_back(obj);
+		};
+		if (obj) {
+			add(obj);
+		} else {
+			for (auto obj : CCArrayExt<GameObject*>(objects)) {
+				add(obj);
+			}
+		}
+	}
+
+
+	// all objects of the selection got the same layer
+	void collapseSummary(std::unordered_map<int, int>& summary, int layer, bool isL2 = false) {
+		summary.clear();
+		if (isL2 && layer <= 0) return;
+		summary.insert({layer, m_fields->selectionSize});
+	}
+
+
 	int getL1Value() {
 		if (!m_fields->isBetterEdit) {
 			return m_editorLayerValue;
@@ -371,6 +713,7 @@ class $modify(MySetGroupIDLayer, SetGroupIDLayer) {
 		for (auto* obj : m_fields->betterEdit.objects) {
 			obj->m_editorLayer = value;
 		}
+		collapseSummary(m_fields->summaryL1, value);
 		m_fields->betterEdit.inputL1->setString(std::to_string(value));
 	}
 
@@ -383,38 +726,71 @@ class $modify(MySetGroupIDLayer, SetGroupIDLayer) {
 		for (auto* obj : m_fields->betterEdit.objects) {
 			obj->m_editorLayer2 = value;
 		}
+		collapseSummary(m_fields->summaryL2, value, true);
 		m_fields->betterEdit.inputL2->setString(std::to_string(value));
 	}
 
 
 	void checkLayers(float) {
-		if (getL1Value() != m_fields->layer1) {
-			// L1 changed
-			updateLabelText(m_fields->lab1, getL1Value());
-			m_fields->layer1 = getL1Value();
+		int l1 = getL1Value();
+		if (l1 != m_fields->layer1) {
+			// L1 changed (the value is applied to the whole selection)
+			if (m_fields->layer1 != -990 && l1 != -1) collapseSummary(m_fields->summaryL1, l1);
+			updateLabelText(m_fields->lab1, l1, m_fields->summaryL1);
+			m_fields->layer1 = l1;
 		}
-		if (getL2Value() != m_fields->layer2) {
+		int l2 = getL2Value();
+		if (l2 != m_fields->layer2) {
 			// L2 changed
-			updateLabelText(m_fields->lab2, getL2Value());
-			m_fields->layer2 = getL2Value();
+			if (m_fields->layer2 != -990 && l2 != -1) collapseSummary(m_fields->summaryL2, l2, true);
+			updateLabelText(m_fields->lab2, l2, m_fields->summaryL2);
+			m_fields->layer2 = l2;
+		}
+	}
+
+
+	// e.g. "bg (1200), fx (30)"
+	std::string summaryText(const std::unordered_map<int, int>& summary, const LayerNames& names) {
+		std::vector<std::pair<int, int>> layers(summary.begin(), summary.end());
+		std::sort(layers.begin(), layers.end(), [](std::pair<int, int> a, std::pair<int, int> b){return a.second > b.second;});
+		std::string text;
+		for (int i = 0; i < (int)layers.size(); i++) {
+			if (i == 3) {
+				text += ", ...";
+				break;
+			}
+			auto [layer, count] = layers[i];
+			auto it = names.find(layer);
+			auto name = (it != names.end()) ? it->second : std::to_string(layer);
+			text += fmt::format("{}{} ({})", (i ? ", " : ""), name, count);
 		}
+		return text;
 	}
 
 
-	void updateLabelText(CCLabelBMFont* lab, int layer) {
-		const char* text = " - ";
-		if (layer != -1) {
-			auto editor = reinterpret_cast<MyEditorUI*>(EditorUI::get());
-			auto it = editor->m_fields->layerNames.find(layer);
-			if (it != editor->m_fields->layerNames.end()) {
-				text = it->second.c_str();
+	void updateLabelText(CCLabelBMFont* lab, int layer, const std::unordered_map<int, int>& summary) {
+		std::string text = " - ";
+		auto names = reinterpret_cast<MyEditorUI*>(EditorUI::get())->m_fields->layerNames.snapshot();
+		// mixed values: a single layer is listed too, when the other objects have no layer 2
+		// (the layer 2 input shows the value of one object then, not -1)
+		int summaryTotal = 0;
+		for (const auto& [summaryLayer, count] : summary) {
+			summaryTotal += count;
+		}
+		bool mixed = summary.size() > 1 || (!summary.empty() && (layer == -1 || summaryTotal < m_fields->selectionSize));
+		if (mixed) {
+			text = summaryText(summary, *names);
+		} else if (layer != -1) {
+			auto it = names->find(layer);
+			if (it != names->end()) {
+				text = it->second;
 			}
 		} else if (m_fields->isBetterEdit) {
 			text = "";
 		}
 
 		// update label
-		lab->setString(text);
+		lab->setString(text.c_str());
 		float availableSpace = 90;
 		float takenSpace = std::max(lab->getContentWidth(), 1.f);
 		lab->setScale(std::min(0.5f, availableSpace / takenSpace));
@@ -428,7 +804,7 @@ class $modify(MySetGroupIDLayer, SetGroupIDLayer) {
 	void onL1Click(CCObject*) {
 		SelectPopup::create({
 			"Select Layer 1",
-			&reinterpret_cast<MyEditorUI*>(EditorUI::get())->m_fields->layerNames, 
+			reinterpret_cast<MyEditorUI*>(EditorUI::get())->m_fields->layerNames.snapshot(),
 			getL1Value(),
 			[this](int layer) {
 				setL1Value(layer);
@@ -440,7 +816,7 @@ class $modify(MySetGroupIDLayer, SetGroupIDLayer) {
 	void onL2Click(CCObject*) {
 		SelectPopup::create({
 			"Select Layer 2",
-			&reinterpret_cast<MyEditorUI*>(EditorUI::get())->m_fields->layerNames, 
+			reinterpret_cast<MyEditorUI*>(EditorUI::get())->m_fields->layerNames.snapshot(),
 			getL2Value(),
 			[this](int layer) {
 				setL2Value(layer);
@@ -451,20 +827,42 @@ class $modify(MySetGroupIDLayer, SetGroupIDLayer) {
 
 	void onClose(CCObject* sender) {
 		unschedule(schedule_selector(MySetGroupIDLayer::checkLayers));
+		// the layer may be released by onClose
+		Ref<GameObject> editedObject = m_fields->editedObject;
+		Ref<CCArray> editedObjects = m_fields->editedObjects;
 		SetGroupIDLayer::onClose(sender);
+		// the layers of the objects could be changed
+		if (auto editor = EditorUI::get()) {
+			auto& index = reinterpret_cast<MyEditorUI*>(editor)->layerIndex();
+			if (editedObject) index.update(editedObject);
+			if (auto objects = editedObjects.data()) {
+				for (auto* obj : CCArrayExt<GameObject*>(objects)) {
+					index.update(obj);
+				}
+			}
+		}
 		EditorUI::get()->updateButtons();
 	}
 };
 
 
 class $modify(GJGameLevel) {
-	// copy layer names with level info
+	// copy layer names, folders and history with level info
 	void copyLevelInfo(GJGameLevel* oldLvl) {
 		GJGameLevel::copyLevelInfo(oldLvl);
 		auto newLvl = this;
 		int newId = EditorIDs::getID(newLvl);
 		int oldId = EditorIDs::getID(oldLvl);
 
+		bool useObject = Mod::get()->getSettingValue<bool>("use-save-object");
+		for (auto key : {"layers", "folders", "layers-history"}) {
+			auto value = SaveLevelDataAPI::getSavedValue(oldLvl, key, true, useObject);
+			if (value.isOk() && !value->isNull()) {
+				SaveLevelDataAPI::setSavedValue(newLvl, key, *value, true, useObject);
+			}
+		}
+
+		// old save (levels that were not saved since the update)
 		auto config = Mod::get()->getSavedValue<std::string>(std::to_string(oldId));
 		if (!config.empty()) {
 			Mod::get()->setSavedValue(std::to_string(newId), config);
@@ -473,17 +871,101 @@ class $modify(GJGameLevel) {
 };
 
 
+class $modify(MyEditLevelLayer, EditLevelLayer) {
+	struct Fields {
+		Ref<ButtonSprite> layersSpr;
+	};
+
+	bool init(GJGameLevel* level) {
+		if (!EditLevelLayer::init(level)) return false;
+
+		auto menu = getChildByID("level-actions-menu");
+		if (!menu) return true;
+
+		// nothing is read here: the level data (and with the save object the whole level)
+		// is read only when the button is pressed, then the result is cached
+		auto spr = ButtonSprite::create(layersButtonText(level).c_str(), "bigFont.fnt", "GJ_button_04.png", 0.8);
+		spr->setScale(0.4);
+		m_fields->layersSpr = spr;
+		auto btn = CCMenuItemSpriteExtra::create(spr, this, menu_selector(MyEditLevelLayer::onLayersButton));
+		btn->setID("layers-button"_spr);
+		menu->addChild(btn);
+		menu->updateLayout();
+
+		return true;
+	}
+
+
+	// only what is already cached
+	static std::string layersButtonText(GJGameLevel* level) {
+		int levelId = EditorIDs::getID(level);
+		auto names = layerNamesCache().find(levelId);
+		auto used = usedLayersCache().find(levelId);
+		if (names == layerNamesCache().end() || used == usedLayersCache().end()) return "Layers";
+		return fmt::format("Layers: {}/{}", names->second->size(), used->second);
+	}
+
+
+	void onLayersButton(CCObject*) {
+		LevelLayersPopup::create(m_level)->show();
+		Ref<ButtonSprite> spr = m_fields->layersSpr;
+		requestLevelSummary(m_level, [spr](const LevelSummary& summary) {
+			spr->setString(fmt::format("Layers: {}/{}", summary.m_names->size(), summary.m_usedLayers).c_str());
+		});
+	}
+};
+
+
 class $modify(EditorPauseLayer) {
 	void saveLevel() {
-		matjson::Value jsonVal;
 		auto editor = reinterpret_cast<MyEditorUI*>(EditorUI::get());
-		for (const auto& [key, value] : editor->m_fields->layerNames) {
-			jsonVal[std::to_string(key)] = value;
-		}
-		bool useObject = Mod::get()->getSettingValue<bool>("use-save-object");
-		SaveLevelDataAPI::setSavedValue(editor->m_editorLayer->m_level, "layers", jsonVal, true, useObject);
+		saveLayerNames(editor->m_editorLayer->m_level, *editor->m_fields->layerNames.snapshot());
+		saveLayerFolders(editor->m_editorLayer->m_level, editor->m_fields->folders);
+		auto& history = editor->m_fields->history;
+		history.sync(*editor->m_fields->layerNames.snapshot());
+		history.seal();
+		saveLayerHistory(editor->m_editorLayer->m_level, history);
 		EditorPauseLayer::saveLevel();
+		invalidateUsedLayers(editor->m_editorLayer->m_level);
 	}
 };
 
 
+// API
+
+static MyEditorUI* apiEditorUI() {
+	auto editor = EditorUI::get();
+	return editor ? reinterpret_cast<MyEditorUI*>(editor) : nullptr;
+}
+
+
+bool api_bridge::isInEditor() {
+	return apiEditorUI() != nullptr;
+}
+
+
+named_layers::NamesSnapshot api_bridge::layerNames() {
+	return apiEditorUI()->m_fields->layerNames.snapshot();
+}
+
+
+std::unordered_map<int, int> api_bridge::objectCounts() {
+	return apiEditorUI()->layerCounts();
+}
+
+
+std::vector<GameObject*> api_bridge::objects(int layer) {
+	return apiEditorUI()->layerObjects(layer);
+}
+
+
+named_layers::LayerChanges api_bridge::currentState() {
+	auto editor = apiEditorUI();
+	auto& layerNames = editor->m_fields->layerNames;
+	named_layers::LayerChanges state{layerNames.version()};
+	auto names = layerNames.snapshot();
+	state.m_names.assign(names->begin(), names->end());
+	auto counts = editor->layerCounts();
+	state.m_counts.assign(counts.begin(), counts.end());
+	return state;
+}
@@ -0,0 +1,154 @@
+struct RemapInfo {
+    std::vector<int> m_usedLayers;
+    std::function<void(const LayerRemapTable& table)> m_applyCallback;
+};
+
+
+class RemapPopup : public Popup {
+private:
+    const float m_width = 300.f;
+    const float m_height = 200.f;
+
+    RemapInfo m_remapInfo;
+
+    TextInput* m_mergeFrom = nullptr;
+    TextInput* m_mergeTo = nullptr;
+    TextInput* m_shiftFirst = nullptr;
+    TextInput* m_shiftLast = nullptr;
+    TextInput* m_shiftOffset = nullptr;
+    CCLabelBMFont* m_errorLab = nullptr;
+
+protected:
+    bool init(RemapInfo remapInfo) {
+        if (!Popup::init(m_width, m_height))
+            return false;
+
+        m_remapInfo = remapInfo;
+        setTitle("Remap Layers");
+
+        auto menu = CCMenu::create();
+        menu->setContentSize(m_mainLayer->getContentSize());
+        m_mainLayer->addChildAtPosition(menu, Anchor::Center);
+
+        auto infoBtn = InfoAlertButton::create("Help",
+            "<cy>Merge</c>: moves all objects of the first layer to the second one.\n"
+            "<cy>Shift</c>: moves the layers of the range by the offset, the layers in the way take the freed place.\n"
+            "<cy>Compact</c>: renumbers all used layers to be contiguous.\n"
+            "Names, lock state and folders move with the objects. "
+            "<cg>The remap can be undone with the editor undo button.</c>", 0.75);
+        menu->addChildAtPosition(infoBtn, Anchor::TopRight, ccp(-18, -18));
+
+        // merge
+        addRowLabel("Merge", 50);
+        m_mergeFrom = addInput("A", 95, 50);
+        addRowLabel("into", 50, 120);
+        m_mergeTo = addInput("B", 155, 50);
+        addApplyButton(menu, menu_selector(RemapPopup::onMerge), 50);
+
+        // shift
+        addRowLabel("Shift", 90);
+        m_shiftFirst = addInput("from", 95, 90);
+        m_shiftLast = addInput("to", 145, 90);
+        m_shiftOffset = addInput("+/-", 195, 90);
+        addApplyButton(menu, menu_selector(RemapPopup::onShift), 90);
+
+        // compact
+        addRowLabel("Compact all used layers", 130);
+        addApplyButton(menu, menu_selector(RemapPopup::onCompact), 130);
+
+        m_errorLab = CCLabelBMFont::create("", "chatFont.fnt");
+        m_errorLab->setColor(ccc3(255,90,90));
+        m_mainLayer->addChildAtPosition(m_errorLab, Anchor::Bottom, ccp(0, 18));
+
+        setID("remap-popup"_spr);
+        return true;
+    }
+
+
+    void addRowLabel(const char* text, float yFromTop, float x = 20) {
+        auto lab = CCLabelBMFont::create(text, "bigFont.fnt");
+        lab->setAnchorPoint({0,0.5});
+        lab->limitLabelWidth(200, 0.4, 0);
+        m_mainLayer->addChildAtPosition(lab, Anchor::TopLeft, ccp(x, -yFromTop));
+    }
+
+
+    TextInput* addInput(const char* placeholder, float x, float yFromTop) {
+        auto input = TextInput::create(45, placeholder);
+        input->setCommonFilter(CommonFilter::Int);
+        input->setScale(0.8);
+        m_mainLayer->addChildAtPosition(input, Anchor::TopLeft, ccp(x, -yFromTop));
+        return input;
+    }
+
+
+    void addApplyButton(CCMenu* menu, SEL_MenuHandler selector, float yFromTop) {
+        auto spr = ButtonSprite::create("ok", "goldFont.fnt", "GJ_button_01.png", 0.8);
+        spr->setScale(0.6);
+        auto btn = CCMenuItemSpriteExtra::create(spr, this, selector);
+        menu->addChildAtPosition(btn, Anchor::TopRight, ccp(-35, -yFromTop));
+    }
+
+
+    std::optional<int> readLayer(TextInput* input) {
+        int value = utils::numFromString<int>(input->getString()).unwrapOr(-1);
+        if (value < 0 || value >= LAYER_COUNT) {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+
+    void showError(const char* text) {
+        m_errorLab->setString(text);
+        m_errorLab->limitLabelWidth(m_width - 40, 0.7, 0);
+    }
+
+
+    void apply(const LayerRemapTable& table) {
+        // the callback may close the parent popup, so this popup is closed first
+        auto callback = m_remapInfo.m_applyCallback;
+        onClose(nullptr);
+        callback(table);
+    }
+
+
+    void onMerge(CCObject*) {
+        auto from = readLayer(m_mergeFrom);
+        auto to = readLayer(m_mergeTo);
+        if (!from || !to) return showError(fmt::format("Layers must be 0-{}", LAYER_COUNT - 1).c_str());
+        if (*from == *to) return showError("Layers must be different");
+        apply(mergeRemap(*from, *to));
+    }
+
+
+    void onShift(CCObject*) {
+        auto first = readLayer(m_shiftFirst);
+        auto last = readLayer(m_shiftLast);
+        auto offsetRes = utils::numFromString<int>(m_shiftOffset->getString());
+        if (!first || !last || offsetRes.isErr()) return showError("Enter the range and the offset");
+        int offset = offsetRes.unwrap();
+        if (*first > *last) std::swap(first, last);
+        if (*first + offset < 0 || *last + offset >= LAYER_COUNT) {
+            return showError(fmt::format("Layers must stay within 0-{}", LAYER_COUNT - 1).c_str());
+        }
+        if (offset == 0) return showError("Offset must not be 0");
+        apply(shiftRemap(*first, *last, offset));
+    }
+
+
+    void onCompact(CCObject*) {
+        apply(compactRemap(m_remapInfo.m_usedLayers));
+    }
+
+public:
+    static RemapPopup* create(RemapInfo remapInfo) {
+        auto ret = new RemapPopup();
+        if (ret && ret->init(remapInfo)) {
+            ret->autorelease();
+            return ret;
+        }
+        CC_SAFE_DELETE(ret);
+        return nullptr;
+    }
+};
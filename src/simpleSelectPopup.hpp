@@ -1,6 +1,6 @@
 struct LayersInfoReduced {
     const char* title;
-    std::unordered_map<int, std::string> *m_layerNames;
+    LayerNameTable::Snapshot m_layerNames;
     int m_currentLayer;
     std::function<void(int layer)> m_updateCallback;
 };